@@ -4,6 +4,12 @@
 #include "UtilityModule.h"
 #include "UObject/Field.h"
 #include "UObject/TextProperty.h"
+#include "UObject/EnumProperty.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/StringBuilder.h"
+#include "Reflection/StructLayout.h"
+#include "Async/ParallelFor.h"
 FString UAtkStructUtilsFunctionLibrary::GetPropertyValueAsString(const FProperty* Property, const void* StructObject, bool& OutResult)
 {
 	OutResult = true;
@@ -67,17 +73,16 @@ void UAtkStructUtilsFunctionLibrary::LogInstancedStruct(const FInstancedStruct&
 {
 	if(Struct.IsValid())
 	{
-		UE_LOG(LogUtilityModule, Warning, TEXT("StructType: %s"), *Struct.GetScriptStruct()->GetName())
-		ForEachProperty(Struct, [&](const FProperty* Property)
-		{
-			const FString PropertyName = Property->GetAuthoredName();
-			bool bOutResult = false;
-			UE_LOG(LogUtilityModule, Display, TEXT("Name: %s ; Value: %s"), *PropertyName,
-				*UAtkStructUtilsFunctionLibrary::GetPropertyValueAsStringFromStruct(Struct, PropertyName, bOutResult));
-		});
+		// one entry per struct, properties are read directly instead of being looked up again by name
+		UE_LOG(LogUtilityModule, Display, TEXT("%s"), *FAtkStructDumper::FormatStruct(FConstStructView(Struct.GetScriptStruct(), Struct.GetMemory())));
 	}
 }
 
+void UAtkStructUtilsFunctionLibrary::DumpInstancedStructs(const TArray<FInstancedStruct>& Structs, const FAtkStructDumpOptions& Options)
+{
+	FAtkStructDumper::DumpAsync(Structs, Options);
+}
+
 
 bool UAtkStructUtilsFunctionLibrary::SetPropertyValueInStruct(FInstancedStruct& InstancedStruct,
                                                                          const FString& PropertyName, const FString& NewValue)
@@ -92,17 +97,358 @@ bool UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(FI
 	const FStructProp Container = GetContainerThatHoldsProperty(PropertyName, InstancedStruct.GetMutableMemory(), InstancedStruct.GetScriptStruct());
 	if(Container.IsValid())
 	{
-		if(SetPropertyValue<FString>(Container.Property, Container.Object, NewValue))
+		return SetPropertyValueFromString(Container.Property, Container.Object, NewValue);
+	}
+
+	return false;
+}
+
+bool UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(FAtkSharedDefaultStructArray& Array, int32 Index,
+	const FString& PropertyName, const FString& NewValue)
+{
+	if(!Array.IsValidIndex(Index))
+		return false;
+
+	const FNestedPropertyPath Path = FindNestedProperty(PropertyName, Array.GetScriptStruct(Index));
+	if(!Path.IsValid())
+		return false;
+
+	const bool bWasShared = Array.IsShared(Index);
+	uint8* Container = Array.GetMutable(Index).GetMemory() + Path.ContainerOffset;
+	if(SetPropertyValueFromString(Path.Property, Container, NewValue))
+		return true;
+
+	// the value was not valid, let the element share the default again
+	if(bWasShared)
+	{
+		Array.ResetToDefault(Index);
+	}
+	return false;
+}
+
+int32 UAtkStructUtilsFunctionLibrary::SetPropertyValuesNestedInStructFromString(FInstancedStruct& InstancedStruct,
+	const TMap<FString, FString>& Values)
+{
+	int32 Applied = 0;
+	for(const auto& [PropertyName, NewValue] : Values)
+	{
+		if(SetPropertyValueNestedInStructFromString(InstancedStruct, PropertyName, NewValue))
+		{
+			Applied++;
+		}
+	}
+	return Applied;
+}
+
+int32 UAtkStructUtilsFunctionLibrary::SetPropertyValuesNestedInStructFromString(FInstancedStruct& InstancedStruct,
+	TConstArrayView<TPair<FString, FString>> Values)
+{
+	int32 Applied = 0;
+	for(const TPair<FString, FString>& Edit : Values)
+	{
+		if(SetPropertyValueNestedInStructFromString(InstancedStruct, Edit.Key, Edit.Value))
+		{
+			Applied++;
+		}
+	}
+	return Applied;
+}
+
+int32 UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructsFromString(TConstArrayView<FInstancedStruct*> InstancedStructs,
+	const FString& PropertyName, TConstArrayView<FString> NewValues)
+{
+	// rows of a pasted column usually share the same type, resolve the path and the parser once per type
+	const UScriptStruct* CachedType = nullptr;
+	FNestedPropertyPath CachedPath;
+	FStringImportFunc CachedImporter = nullptr;
+
+	int32 Applied = 0;
+	const int32 Num = FMath::Min(InstancedStructs.Num(), NewValues.Num());
+	for(int32 i = 0; i < Num; ++i)
+	{
+		FInstancedStruct* InstancedStruct = InstancedStructs[i];
+		if(!InstancedStruct || !InstancedStruct->IsValid())
+			continue;
+
+		if(InstancedStruct->GetScriptStruct() != CachedType)
+		{
+			CachedType = InstancedStruct->GetScriptStruct();
+			CachedPath = FindNestedProperty(PropertyName, CachedType);
+			CachedImporter = CachedPath.IsValid() ? ResolveStringImporter(CachedPath.Property) : nullptr;
+		}
+		if(!CachedImporter)
+			continue;
+
+		uint8* Container = InstancedStruct->GetMutableMemory() + CachedPath.ContainerOffset;
+		if(CachedImporter(CachedPath.Property, CachedPath.Property->ContainerPtrToValuePtr<void>(Container), NewValues[i]))
+		{
+			Applied++;
+		}
+	}
+	return Applied;
+}
+
+TArray<int32> UAtkStructUtilsFunctionLibrary::FindStructsWithPropertyValue(TConstArrayView<FInstancedStruct> InstancedStructs,
+	const FString& PropertyName, const FString& Value)
+{
+	const UScriptStruct* CachedType = nullptr;
+	FNestedPropertyPath CachedPath;
+
+	TArray<int32> Indices;
+	for(int32 i = 0; i < InstancedStructs.Num(); ++i)
+	{
+		const FInstancedStruct& InstancedStruct = InstancedStructs[i];
+		if(!InstancedStruct.IsValid())
+			continue;
+
+		if(InstancedStruct.GetScriptStruct() != CachedType)
+		{
+			CachedType = InstancedStruct.GetScriptStruct();
+			CachedPath = FindNestedProperty(PropertyName, CachedType);
+		}
+		if(CachedPath.IsValid() && GetPropertyValueAsString(CachedPath.Property, InstancedStruct.GetMemory() + CachedPath.ContainerOffset) == Value)
+		{
+			Indices.Add(i);
+		}
+	}
+	return Indices;
+}
+
+namespace AtkStringImport
+{
+	static bool IsBoolString(const FString& Value)
+	{
+		static const TCHAR* const Tokens[] = { TEXT("true"), TEXT("false"), TEXT("yes"), TEXT("no"), TEXT("on"), TEXT("off"), TEXT("1"), TEXT("0") };
+		for(const TCHAR* Token : Tokens)
+		{
+			if(Value.Equals(Token, ESearchCase::IgnoreCase))
+				return true;
+		}
+		return false;
+	}
+
+	static bool ImportEnumValue(const UEnum* Enum, const FString& Value, int64& OutValue)
+	{
+		if(!Enum)
+			return false;
+		
+		if(Value.IsNumeric())
+		{
+			OutValue = FCString::Atoi64(*Value);
+			return Enum->IsValidEnumValue(OutValue);
+		}
+
+		OutValue = Enum->GetValueByNameString(Value);
+		if(OutValue != INDEX_NONE)
 			return true;
-		if(SetPropertyValue<int32>(Container.Property, Container.Object, FCString::Atoi(*NewValue)))
+
+		// spreadsheets usually hold the display name of the entry
+		for(int32 Index = 0; Index < Enum->NumEnums(); ++Index)
+		{
+			if(Enum->GetDisplayNameTextByIndex(Index).ToString().Equals(Value, ESearchCase::IgnoreCase))
+			{
+				OutValue = Enum->GetValueByIndex(Index);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Whole numbers only, an optional sign then digits, OutMagnitude is false when it does not fit in 64 bits
+	static bool ParseInteger(const FString& Value, bool& bOutNegative, uint64& OutMagnitude)
+	{
+		const TCHAR* Chars = *Value;
+		bOutNegative = *Chars == TEXT('-');
+		if(*Chars == TEXT('-') || *Chars == TEXT('+'))
+			++Chars;
+		if(!*Chars)
+			return false;
+		
+		OutMagnitude = 0;
+		for(; *Chars; ++Chars)
+		{
+			if(!FChar::IsDigit(*Chars))
+				return false;
+			
+			const uint64 Digit = *Chars - TEXT('0');
+			if(OutMagnitude > (MAX_uint64 - Digit) / 10)
+				return false;
+			OutMagnitude = OutMagnitude * 10 + Digit;
+		}
+		return true;
+	}
+
+	static bool ImportNumeric(const FProperty* Property, void* ValuePtr, const FString& Value)
+	{
+		const FNumericProperty* NumericProperty = static_cast<const FNumericProperty*>(Property);
+		const FString Trimmed = Value.TrimStartAndEnd();
+		if(NumericProperty->IsFloatingPoint())
+		{
+			if(!Trimmed.IsNumeric())
+				return false;
+			
+			NumericProperty->SetNumericPropertyValueFromString(ValuePtr, *Trimmed);
 			return true;
-		if(SetPropertyValue<float>(Container.Property, Container.Object, FCString::Atof(*NewValue)))
+		}
+
+		// integers refuse fractions and values out of their range instead of truncating or wrapping them
+		bool bNegative = false;
+		uint64 Magnitude = 0;
+		if(!ParseInteger(Trimmed, bNegative, Magnitude))
+			return false;
+
+		const int32 NumBits = Property->ElementSize * 8;
+		const bool bUnsigned = Property->IsA<FByteProperty>() || Property->IsA<FUInt16Property>() || Property->IsA<FUInt32Property>()
+			|| Property->IsA<FUInt64Property>();
+		if(bUnsigned)
+		{
+			const uint64 Max = NumBits >= 64 ? MAX_uint64 : (uint64(1) << NumBits) - 1;
+			if((bNegative && Magnitude != 0) || Magnitude > Max)
+				return false;
+			
+			NumericProperty->SetIntPropertyValue(ValuePtr, Magnitude);
 			return true;
+		}
+		
+		const uint64 Max = (uint64(1) << (NumBits - 1)) - 1;
+		if(Magnitude > (bNegative ? Max + 1 : Max))
+			return false;
+		
+		NumericProperty->SetIntPropertyValue(ValuePtr, bNegative ? static_cast<int64>(0 - Magnitude) : static_cast<int64>(Magnitude));
+		return true;
 	}
 
-	return false;
+	static bool ImportByte(const FProperty* Property, void* ValuePtr, const FString& Value)
+	{
+		const FByteProperty* ByteProperty = static_cast<const FByteProperty*>(Property);
+		if(!ByteProperty->Enum)
+			return ImportNumeric(Property, ValuePtr, Value);
+
+		int64 EnumValue = 0;
+		if(!ImportEnumValue(ByteProperty->Enum, Value.TrimStartAndEnd(), EnumValue))
+			return false;
+
+		ByteProperty->SetIntPropertyValue(ValuePtr, EnumValue);
+		return true;
+	}
+
+	static bool ImportEnum(const FProperty* Property, void* ValuePtr, const FString& Value)
+	{
+		const FEnumProperty* EnumProperty = static_cast<const FEnumProperty*>(Property);
+		int64 EnumValue = 0;
+		if(!ImportEnumValue(EnumProperty->GetEnum(), Value.TrimStartAndEnd(), EnumValue))
+			return false;
+
+		EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(ValuePtr, EnumValue);
+		return true;
+	}
+
+	static bool ImportBool(const FProperty* Property, void* ValuePtr, const FString& Value)
+	{
+		const FString Trimmed = Value.TrimStartAndEnd();
+		if(!IsBoolString(Trimmed))
+			return false;
+		
+		static_cast<const FBoolProperty*>(Property)->SetPropertyValue(ValuePtr, Trimmed.ToBool());
+		return true;
+	}
+
+	static bool ImportStr(const FProperty* Property, void* ValuePtr, const FString& Value)
+	{
+		static_cast<const FStrProperty*>(Property)->SetPropertyValue(ValuePtr, Value);
+		return true;
+	}
+
+	static bool ImportName(const FProperty* Property, void* ValuePtr, const FString& Value)
+	{
+		static_cast<const FNameProperty*>(Property)->SetPropertyValue(ValuePtr, FName(*Value));
+		return true;
+	}
+
+	static bool ImportText(const FProperty* Property, void* ValuePtr, const FString& Value)
+	{
+		static_cast<const FTextProperty*>(Property)->SetPropertyValue(ValuePtr, FText::FromString(Value));
+		return true;
+	}
+
+	static bool ImportGeneric(const FProperty* Property, void* ValuePtr, const FString& Value)
+	{
+		return Property->ImportText_Direct(*Value, ValuePtr, nullptr, PPF_None) != nullptr;
+	}
+
+	static bool ImportStruct(const FProperty* Property, void* ValuePtr, const FString& Value)
+	{
+		// (X=1,Y=2,Z=3) style text
+		const FString Trimmed = Value.TrimStartAndEnd();
+		if(Trimmed.StartsWith(TEXT("(")))
+			return ImportGeneric(Property, ValuePtr, Trimmed);
+
+		// spreadsheet style "1,2,3", assigned in order to the numeric members of the struct
+		TArray<FString> Parts;
+		Trimmed.ParseIntoArray(Parts, TEXT(","), false);
+		const UScriptStruct* Struct = static_cast<const FStructProperty*>(Property)->Struct;
+		TArray<const FNumericProperty*> Members;
+		for(TFieldIterator<FNumericProperty> It(Struct); It; ++It)
+		{
+			Members.Add(*It);
+		}
+		if(Parts.Num() < 2 || Parts.Num() != Members.Num())
+			return ImportGeneric(Property, ValuePtr, Trimmed);
+
+		for(const FString& Part : Parts)
+		{
+			if(!Part.TrimStartAndEnd().IsNumeric())
+				return false;
+		}
+		for(int32 i = 0; i < Parts.Num(); ++i)
+		{
+			Members[i]->SetNumericPropertyValueFromString(Members[i]->ContainerPtrToValuePtr<void>(ValuePtr), *Parts[i].TrimStartAndEnd());
+		}
+		return true;
+	}
+
+	static const TMap<FFieldClass*, UAtkStructUtilsFunctionLibrary::FStringImportFunc>& GetImporters()
+	{
+		static const TMap<FFieldClass*, UAtkStructUtilsFunctionLibrary::FStringImportFunc> Importers
+		{
+			{ FNumericProperty::StaticClass(), &ImportNumeric },
+			{ FByteProperty::StaticClass(), &ImportByte },
+			{ FEnumProperty::StaticClass(), &ImportEnum },
+			{ FBoolProperty::StaticClass(), &ImportBool },
+			{ FStrProperty::StaticClass(), &ImportStr },
+			{ FNameProperty::StaticClass(), &ImportName },
+			{ FTextProperty::StaticClass(), &ImportText },
+			{ FStructProperty::StaticClass(), &ImportStruct },
+		};
+		return Importers;
+	}
+}
+
+UAtkStructUtilsFunctionLibrary::FStringImportFunc UAtkStructUtilsFunctionLibrary::ResolveStringImporter(const FProperty* Property)
+{
+	if(!Property)
+		return nullptr;
+	
+	const TMap<FFieldClass*, FStringImportFunc>& Importers = AtkStringImport::GetImporters();
+	// walk up the field class hierarchy so every numeric subclass ends up in the numeric parser
+	for(FFieldClass* Class = Property->GetClass(); Class; Class = Class->GetSuperClass())
+	{
+		if(const FStringImportFunc* Importer = Importers.Find(Class))
+		{
+			return *Importer;
+		}
+	}
+	return &AtkStringImport::ImportGeneric;
 }
 
+bool UAtkStructUtilsFunctionLibrary::SetPropertyValueFromString(const FProperty* Property, void* Container, const FString& NewValue)
+{
+	if(!Property || !Container)
+		return false;
+
+	const FStringImportFunc Importer = ResolveStringImporter(Property);
+	return Importer(Property, Property->ContainerPtrToValuePtr<void>(Container), NewValue);
+}
 
 FProperty* UAtkStructUtilsFunctionLibrary::FindPropertyByDisplayName(const UStruct* Struct,const FName& DisplayName )
 {
@@ -121,6 +467,28 @@ FProperty* UAtkStructUtilsFunctionLibrary::FindPropertyByDisplayName(const UStru
 	return nullptr;
 }
 
+FProperty* UAtkStructUtilsFunctionLibrary::FindPropertyByName(const UStruct* Struct, const FName& Name)
+{
+	if(!Struct || Name.IsNone())
+		return nullptr;
+
+	if(FProperty* Property = FindFProperty<FProperty>(Struct, Name))
+	{
+		return Property;
+	}
+
+	// user defined structs suffix their internal names, fall back on the name shown in the editor
+	const FString AuthoredName = Name.ToString();
+	for(FProperty* Property = Struct->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+	{
+		if(Property->GetAuthoredName().Equals(AuthoredName, ESearchCase::IgnoreCase))
+		{
+			return Property;
+		}
+	}
+	return nullptr;
+}
+
 FProperty* UAtkStructUtilsFunctionLibrary::FindPropertyByDisplayName(const TArray<const UStruct*>& Structs,
 	const FName& DisplayName)
 {
@@ -152,70 +520,435 @@ TArray<const FProperty*> UAtkStructUtilsFunctionLibrary::GetOrderedProperties(co
 
 TArray<const FProperty*> UAtkStructUtilsFunctionLibrary::GetOrderedProperties(const UScriptStruct* ScriptStruct)
 {
-	TArray<const FProperty*> ParentProperties;
-	TArray<const FProperty*> ChildProperties;
-	if(!ScriptStruct)
-		return ParentProperties;
-	// Iterate through the properties in the struct
-	for (TFieldIterator<FProperty> It(ScriptStruct); It; ++It)
+	const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = FAtkStructLayout::Get(ScriptStruct);
+	if(!Layout)
+		return TArray<const FProperty*>();
+	
+	return TArray<const FProperty*>(Layout->GetOrderedProperties());
+}
+
+FString UAtkStructUtilsFunctionLibrary::GetPropertyValueAsString(const FProperty* Property, const void* Data)
+{
+	if(!Data || !Property)
+		return FString();
+
+	const uint8* PropertyAddr = Property->ContainerPtrToValuePtr<uint8>(Data);
+	if (!PropertyAddr)
+	{
+		return FString();
+	}
+	
+	FString ValueText;
+	Property->ExportTextItem_Direct(ValueText, PropertyAddr, nullptr, nullptr, PPF_None);
+	return ValueText;
+}
+
+namespace AtkStructDiff
+{
+	// Calls Func(Property, Index, bChanged) for every property of the struct in PropertyLink order
+	// runs of memory comparable properties are checked together and only split when the run differs
+	// Every element of a fixed size array property, Identical_InContainer only compares the element it is given
+	static bool IsIdentical(const FProperty* Property, const uint8* OldData, const uint8* NewData)
 	{
-		const FProperty* Property = *It;
-		// Check if the property is from the base struct (parent) or derived struct (child)
-		if (Property->GetOwnerStruct()->GetInheritanceSuper())
+		for(int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
 		{
-			// This is a child property
-			ChildProperties.Add(Property);
+			if(!Property->Identical_InContainer(OldData, NewData, ArrayIndex, PPF_None))
+				return false;
 		}
-		else
+		return true;
+	}
+
+	template <typename FuncType>
+	static void VisitProperties(const UScriptStruct* StructType, const uint8* OldData, const uint8* NewData, FuncType Func)
+	{
+		const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = FAtkStructLayout::Get(StructType);
+		const TConstArrayView<FAtkStructLayout::FPropertyLayout> Properties = Layout->GetProperties();
+		const TConstArrayView<FAtkStructLayout::FMemoryRun> Runs = Layout->GetComparableRuns();
+		
+		for(int32 Index = 0; Index < Properties.Num();)
 		{
-			// This is a parent property
-			ParentProperties.Add(Property);
+			const FAtkStructLayout::FPropertyLayout& Property = Properties[Index];
+			if(Property.ComparableRun == INDEX_NONE)
+			{
+				Func(Property.Property, Index, !IsIdentical(Property.Property, OldData, NewData));
+				++Index;
+				continue;
+			}
+
+			const FAtkStructLayout::FMemoryRun& Run = Runs[Property.ComparableRun];
+			const bool bRunChanged = FMemory::Memcmp(OldData + Run.Offset, NewData + Run.Offset, Run.Size) != 0;
+			for(int32 RunIndex = Run.FirstProperty; RunIndex < Run.FirstProperty + Run.NumProperties; ++RunIndex)
+			{
+				const FAtkStructLayout::FPropertyLayout& RunProperty = Properties[RunIndex];
+				const bool bChanged = bRunChanged && FMemory::Memcmp(OldData + RunProperty.Offset, NewData + RunProperty.Offset, RunProperty.Size) != 0;
+				Func(RunProperty.Property, RunIndex, bChanged);
+			}
+			Index = Run.FirstProperty + Run.NumProperties;
 		}
 	}
+}
 
-	TArray<const FProperty*> OrderedProperties;
-	OrderedProperties.Append(ParentProperties);
-	OrderedProperties.Append(ChildProperties);
+bool UAtkStructUtilsFunctionLibrary::DiffStructs(const UScriptStruct* StructType, const void* OldData, const void* NewData,
+	TBitArray<>& OutChanged)
+{
+	OutChanged.Reset();
+	if(!StructType || !OldData || !NewData)
+		return false;
 
-	// Put ID property at the beginning
-	for (int32 i = 0; i < OrderedProperties.Num(); ++i)
+	bool bAnyChanged = false;
+	AtkStructDiff::VisitProperties(StructType, static_cast<const uint8*>(OldData), static_cast<const uint8*>(NewData),
+		[&](const FProperty* Property, int32 Index, bool bChanged)
 	{
-		const FProperty* IDProp = ParentProperties[i];
-		const FString StaticPropertyName = IDProp->GetName();
-		if (StaticPropertyName.Contains(FString("ID")))
+		OutChanged.Add(bChanged);
+		bAnyChanged |= bChanged;
+	});
+	return bAnyChanged;
+}
+
+bool UAtkStructUtilsFunctionLibrary::DiffStructs(const UScriptStruct* StructType, const void* OldData, const void* NewData,
+	TArray<FString>& OutChangedPaths, const FString& PathPrefix)
+{
+	if(!StructType || !OldData || !NewData)
+		return false;
+
+	bool bAnyChanged = false;
+	AtkStructDiff::VisitProperties(StructType, static_cast<const uint8*>(OldData), static_cast<const uint8*>(NewData),
+		[&](const FProperty* Property, int32 Index, bool bChanged)
+	{
+		if(!bChanged)
+			return;
+		
+		bAnyChanged = true;
+		const FString Path = PathPrefix.IsEmpty() ? Property->GetAuthoredName() : PathPrefix + TEXT(".") + Property->GetAuthoredName();
+		// only recurse into nested structs that are known to differ
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if(StructProperty && StructProperty->ArrayDim == 1)
 		{
-			OrderedProperties.RemoveAt(i);
-			OrderedProperties.Insert(IDProp, 0);
-			break;
+			const int32 NumBefore = OutChangedPaths.Num();
+			DiffStructs(StructProperty->Struct, StructProperty->ContainerPtrToValuePtr<void>(OldData),
+				StructProperty->ContainerPtrToValuePtr<void>(NewData), OutChangedPaths, Path);
+			if(OutChangedPaths.Num() > NumBefore)
+				return;
 		}
+		OutChangedPaths.Add(Path);
+	});
+	return bAnyChanged;
+}
+
+bool UAtkStructUtilsFunctionLibrary::DiffInstancedStructs(const FInstancedStruct& OldStruct, const FInstancedStruct& NewStruct,
+	TBitArray<>& OutChanged)
+{
+	const UScriptStruct* StructType = NewStruct.GetScriptStruct();
+	if(OldStruct.GetScriptStruct() != StructType)
+	{
+		// a different type changes every property
+		OutChanged.Reset();
+		ForEachProperty(NewStruct, [&](const FProperty* Property)
+		{
+			OutChanged.Add(true);
+		});
+		return true;
 	}
-	return OrderedProperties;
+	return DiffStructs(StructType, OldStruct.GetMemory(), NewStruct.GetMemory(), OutChanged);
 }
 
-FString UAtkStructUtilsFunctionLibrary::GetPropertyValueAsString(const FProperty* Property, const void* Data)
+TArray<FString> UAtkStructUtilsFunctionLibrary::GetChangedPropertyPaths(const FInstancedStruct& OldStruct, const FInstancedStruct& NewStruct)
 {
-	if(!Data || !Property)
-		return FString();
+	TArray<FString> ChangedPaths;
+	const UScriptStruct* StructType = NewStruct.GetScriptStruct();
+	if(OldStruct.GetScriptStruct() != StructType)
+	{
+		ForEachProperty(NewStruct, [&](const FProperty* Property)
+		{
+			ChangedPaths.Add(Property->GetAuthoredName());
+		});
+		return ChangedPaths;
+	}
+	
+	DiffStructs(StructType, OldStruct.GetMemory(), NewStruct.GetMemory(), ChangedPaths);
+	return ChangedPaths;
+}
 
-	const uint8* PropertyAddr = Property->ContainerPtrToValuePtr<uint8>(Data);
-	if (!PropertyAddr)
+namespace AtkStructHash
+{
+	static uint64 HashChars(const TCHAR* Chars, int32 Len, uint64 Seed, bool bIgnoreCase)
 	{
-		return FString();
+		if(!bIgnoreCase)
+		{
+			return CityHash64WithSeed(reinterpret_cast<const char*>(Chars), Len * sizeof(TCHAR), Seed);
+		}
+		TArray<TCHAR, TInlineAllocator<128>> Lower;
+		Lower.SetNumUninitialized(Len);
+		for(int32 i = 0; i < Len; ++i)
+		{
+			Lower[i] = FChar::ToLower(Chars[i]);
+		}
+		return CityHash64WithSeed(reinterpret_cast<const char*>(Lower.GetData()), Len * sizeof(TCHAR), Seed);
+	}
+
+	static uint64 HashName(const FName& Name, uint64 Seed)
+	{
+		TStringBuilder<128> Builder;
+		Name.AppendString(Builder);
+		return HashChars(Builder.GetData(), Builder.Len(), Seed, true);
+	}
+
+	static uint64 HashStructMembers(const FAtkStructLayout& Layout, const uint8* Data, uint64 Seed)
+	{
+		const TConstArrayView<FAtkStructLayout::FPropertyLayout> Properties = Layout.GetProperties();
+		const TConstArrayView<FAtkStructLayout::FMemoryRun> Runs = Layout.GetHashableRuns();
+		for(int32 Index = 0; Index < Properties.Num();)
+		{
+			const FAtkStructLayout::FPropertyLayout& Property = Properties[Index];
+			if(Property.HashableRun != INDEX_NONE)
+			{
+				const FAtkStructLayout::FMemoryRun& Run = Runs[Property.HashableRun];
+				Seed = CityHash64WithSeed(reinterpret_cast<const char*>(Data + Run.Offset), Run.Size, Seed);
+				Index = Run.FirstProperty + Run.NumProperties;
+				continue;
+			}
+
+			for(int32 ArrayIndex = 0; ArrayIndex < Property.Property->ArrayDim; ++ArrayIndex)
+			{
+				Seed = UAtkStructUtilsFunctionLibrary::HashPropertyValue(Property.Property, Property.Property->ContainerPtrToValuePtr<void>(Data, ArrayIndex), Seed);
+			}
+			++Index;
+		}
+		return Seed;
+	}
+}
+
+uint64 UAtkStructUtilsFunctionLibrary::HashPropertyValue(const FProperty* Property, const void* ValuePtr, uint64 Seed)
+{
+	if(FAtkStructLayout::IsMemoryHashable(Property))
+	{
+		return CityHash64WithSeed(static_cast<const char*>(ValuePtr), Property->ElementSize, Seed);
+	}
+	// -0.0 and 0.0 are equal, hash them as the same value
+	if(const FFloatProperty* FloatProperty = CastField<FFloatProperty>(Property))
+	{
+		const float Value = FloatProperty->GetPropertyValue(ValuePtr);
+		const float Canonical = Value == 0.f ? 0.f : Value;
+		return CityHash64WithSeed(reinterpret_cast<const char*>(&Canonical), sizeof(Canonical), Seed);
+	}
+	if(const FDoubleProperty* DoubleProperty = CastField<FDoubleProperty>(Property))
+	{
+		const double Value = DoubleProperty->GetPropertyValue(ValuePtr);
+		const double Canonical = Value == 0.0 ? 0.0 : Value;
+		return CityHash64WithSeed(reinterpret_cast<const char*>(&Canonical), sizeof(Canonical), Seed);
+	}
+	if(const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+	{
+		const uint8 Value = BoolProperty->GetPropertyValue(ValuePtr) ? 1 : 0;
+		return CityHash64WithSeed(reinterpret_cast<const char*>(&Value), sizeof(Value), Seed);
+	}
+	if(const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+	{
+		const FString& Value = StrProperty->GetPropertyValue(ValuePtr);
+		return AtkStructHash::HashChars(*Value, Value.Len(), Seed, false);
+	}
+	if(const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+	{
+		return AtkStructHash::HashName(NameProperty->GetPropertyValue(ValuePtr), Seed);
+	}
+	if(const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+	{
+		const FString& Value = TextProperty->GetPropertyValue(ValuePtr).ToString();
+		return AtkStructHash::HashChars(*Value, Value.Len(), Seed, false);
+	}
+	if(const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		return AtkStructHash::HashStructMembers(*FAtkStructLayout::Get(StructProperty->Struct), static_cast<const uint8*>(ValuePtr), Seed);
+	}
+	if(const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+		const int32 Num = Helper.Num();
+		Seed = CityHash64WithSeed(reinterpret_cast<const char*>(&Num), sizeof(Num), Seed);
+		for(int32 i = 0; i < Num; ++i)
+		{
+			Seed = HashPropertyValue(ArrayProperty->Inner, Helper.GetRawPtr(i), Seed);
+		}
+		return Seed;
 	}
 	
+	// maps, sets and object references, hash their text form
 	FString ValueText;
-	Property->ExportTextItem_Direct(ValueText, PropertyAddr, nullptr, nullptr, PPF_None);
-	return ValueText;
+	Property->ExportTextItem_Direct(ValueText, ValuePtr, nullptr, nullptr, PPF_None);
+	return AtkStructHash::HashChars(*ValueText, ValueText.Len(), Seed, false);
+}
+
+uint64 UAtkStructUtilsFunctionLibrary::HashStruct(const UScriptStruct* StructType, const void* Data, uint64 Seed)
+{
+	if(!StructType || !Data)
+		return 1;
+
+	const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = FAtkStructLayout::Get(StructType);
+	const uint64 Hash = AtkStructHash::HashStructMembers(*Layout, static_cast<const uint8*>(Data), Seed ^ Layout->GetTypeSeed());
+	return Hash != 0 ? Hash : 1;
+}
+
+bool UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual(const FInstancedStruct& A, const FInstancedStruct& B)
+{
+	if(A.GetScriptStruct() != B.GetScriptStruct())
+		return false;
+	if(!A.IsValid())
+		return true;
+	
+	return FAtkStructLayout::Get(A.GetScriptStruct())->CompareStruct(A.GetMemory(), B.GetMemory());
+}
+
+int64 UAtkStructUtilsFunctionLibrary::GetInstancedStructHash(const FInstancedStruct& InstancedStruct)
+{
+	return static_cast<int64>(HashStruct(InstancedStruct.GetScriptStruct(), InstancedStruct.GetMemory()));
+}
+
+TArray<int64> UAtkStructUtilsFunctionLibrary::GetInstancedStructHashes(const TArray<FInstancedStruct>& InstancedStructs)
+{
+	TArray<int64> Hashes;
+	Hashes.Reserve(InstancedStructs.Num());
+	for(const FInstancedStruct& InstancedStruct : InstancedStructs)
+	{
+		Hashes.Add(GetInstancedStructHash(InstancedStruct));
+	}
+	return Hashes;
+}
+
+int32 UAtkStructUtilsFunctionLibrary::RemoveDuplicateStructs(TArray<FInstancedStruct>& InstancedStructs)
+{
+	// hash -> index of the first struct kept with that hash, collisions are confirmed with a full compare
+	TMultiMap<uint64, int32> Seen;
+	Seen.Reserve(InstancedStructs.Num());
+	int32 WriteIndex = 0;
+	for(int32 ReadIndex = 0; ReadIndex < InstancedStructs.Num(); ++ReadIndex)
+	{
+		const uint64 Hash = HashStruct(InstancedStructs[ReadIndex].GetScriptStruct(), InstancedStructs[ReadIndex].GetMemory());
+		bool bDuplicate = false;
+		for(auto It = Seen.CreateConstKeyIterator(Hash); It; ++It)
+		{
+			if(AreInstancedStructsEqual(InstancedStructs[It.Value()], InstancedStructs[ReadIndex]))
+			{
+				bDuplicate = true;
+				break;
+			}
+		}
+		if(bDuplicate)
+			continue;
+
+		if(WriteIndex != ReadIndex)
+		{
+			InstancedStructs[WriteIndex] = MoveTemp(InstancedStructs[ReadIndex]);
+		}
+		Seen.Add(Hash, WriteIndex);
+		WriteIndex++;
+	}
+	
+	const int32 Removed = InstancedStructs.Num() - WriteIndex;
+	InstancedStructs.SetNum(WriteIndex);
+	return Removed;
 }
 
 TArray<FInstancedStruct> UAtkStructUtilsFunctionLibrary::CreateInstancedStructArray(int32 Size,
 	const FInstancedStruct& Default)
 {
 	TArray<FInstancedStruct> Array;
-	Array.Init(Default, Size);
+	if(Size <= 0)
+		return Array;
+	
+	// empty instanced structs are cheap, payloads are created in place below instead of copy constructing from Default
+	Array.SetNum(Size);
+	const UScriptStruct* StructType = Default.GetScriptStruct();
+	if(!StructType)
+		return Array;
+
+	// InitializeAs copies the default with a memcpy when the struct is plain old data
+	const uint8* DefaultMemory = Default.GetMemory();
+	constexpr int32 BatchSize = 1024;
+	constexpr int32 MinParallelSize = 8 * BatchSize;
+	const int32 NumBatches = FMath::DivideAndRoundUp(Size, BatchSize);
+	ParallelFor(NumBatches, [&Array, StructType, DefaultMemory, Size](int32 Batch)
+	{
+		const int32 End = FMath::Min((Batch + 1) * BatchSize, Size);
+		for(int32 Index = Batch * BatchSize; Index < End; ++Index)
+		{
+			Array[Index].InitializeAs(StructType, DefaultMemory);
+		}
+	}, Size < MinParallelSize ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
 	return Array;
 }
 
+TArray<int32> UAtkStructUtilsFunctionLibrary::GroupIndicesByStruct(TConstArrayView<FInstancedStruct> InstancedStructs,
+	const UScriptStruct* Filter)
+{
+	TMap<const UScriptStruct*, TArray<int32>> Groups;
+	const UScriptStruct* LastType = nullptr;
+	TArray<int32>* LastGroup = nullptr;
+	for(int32 Index = 0; Index < InstancedStructs.Num(); ++Index)
+	{
+		const UScriptStruct* Type = InstancedStructs[Index].GetScriptStruct();
+		if(!Type)
+			continue;
+		
+		// Runs of the same type skip the map lookup
+		if(Type != LastType)
+		{
+			LastType = Type;
+			LastGroup = !Filter || Type->IsChildOf(Filter) ? &Groups.FindOrAdd(Type) : nullptr;
+		}
+		if(LastGroup)
+		{
+			LastGroup->Add(Index);
+		}
+	}
+
+	TArray<int32> Indices;
+	Indices.Reserve(InstancedStructs.Num());
+	for(const auto& [Type, Group] : Groups)
+	{
+		Indices.Append(Group);
+	}
+	return Indices;
+}
+
+FAtkStructBuffer UAtkStructUtilsFunctionLibrary::MakeStructBuffer(const TArray<FInstancedStruct>& InstancedStructs)
+{
+	const FInstancedStruct* First = InstancedStructs.FindByPredicate([](const FInstancedStruct& InstancedStruct)
+	{
+		return InstancedStruct.IsValid();
+	});
+	if(!First)
+		return FAtkStructBuffer();
+
+	FAtkStructBuffer Buffer(First->GetScriptStruct(), InstancedStructs.Num());
+	const int32 Added = Buffer.Append(InstancedStructs);
+	if(Added != InstancedStructs.Num())
+	{
+		UE_LOG(LogUtilityModule, Warning, TEXT("MakeStructBuffer : %d structs are not of type %s and were skipped"),
+			InstancedStructs.Num() - Added, *First->GetScriptStruct()->GetName());
+	}
+	return Buffer;
+}
+
+int32 UAtkStructUtilsFunctionLibrary::GetStructBufferNum(const FAtkStructBuffer& Buffer)
+{
+	return Buffer.Num();
+}
+
+FInstancedStruct UAtkStructUtilsFunctionLibrary::GetStructBufferElement(const FAtkStructBuffer& Buffer, int32 Index)
+{
+	return Buffer.GetInstancedStruct(Index);
+}
+
+bool UAtkStructUtilsFunctionLibrary::SetStructBufferElement(FAtkStructBuffer& Buffer, int32 Index, const FInstancedStruct& Value)
+{
+	return Buffer.SetAt(Index, FConstStructView(Value.GetScriptStruct(), Value.GetMemory()));
+}
+
+TArray<FInstancedStruct> UAtkStructUtilsFunctionLibrary::StructBufferToArray(const FAtkStructBuffer& Buffer)
+{
+	return Buffer.ToArray();
+}
+
 UAtkStructUtilsFunctionLibrary::FStructProp UAtkStructUtilsFunctionLibrary::GetContainerThatHoldsProperty(const FString& PropertyName, void* StructMemory,
                                                                                                         const UScriptStruct* StructType)
 {
@@ -223,6 +956,23 @@ UAtkStructUtilsFunctionLibrary::FStructProp UAtkStructUtilsFunctionLibrary::GetC
 	{
 		return FStructProp();
 	}
+
+	const FNestedPropertyPath Path = FindNestedProperty(PropertyName, StructType);
+	if(!Path.IsValid())
+	{
+		return FStructProp();
+	}
+	
+	return FStructProp(StructType, static_cast<uint8*>(StructMemory) + Path.ContainerOffset, Path.Property);
+}
+
+UAtkStructUtilsFunctionLibrary::FNestedPropertyPath UAtkStructUtilsFunctionLibrary::FindNestedProperty(const FString& PropertyName,
+	const UScriptStruct* StructType)
+{
+	if(!StructType)
+	{
+		return FNestedPropertyPath();
+	}
 	
 	for (TFieldIterator<FProperty> It(StructType); It; ++It)
 	{
@@ -232,20 +982,21 @@ UAtkStructUtilsFunctionLibrary::FStructProp UAtkStructUtilsFunctionLibrary::GetC
 			continue;
 		}
 		
-		if(PropertyName == Property->GetAuthoredName())
+		if(PropertyName == Property->GetAuthoredName() || PropertyName == Property->GetName())
 		{
-			return FStructProp(StructType, StructMemory, Property);
+			return FNestedPropertyPath{ Property, 0 };
 		}
 		
 		if(const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
 		{
-			void* SourceData = StructProperty->ContainerPtrToValuePtr<void>(StructMemory);
-			return GetContainerThatHoldsProperty(PropertyName, SourceData, StructProperty->Struct);
+			FNestedPropertyPath Nested = FindNestedProperty(PropertyName, StructProperty->Struct);
+			if(Nested.IsValid())
+			{
+				Nested.ContainerOffset += StructProperty->GetOffset_ForInternal();
+				return Nested;
+			}
 		}
 	}
 
-	return FStructProp();
+	return FNestedPropertyPath();
 }
-
-
-
@@ -8,6 +8,8 @@
 #include "UtilityModule.h"
 #include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
 #include "Engine/DataTable.h"
+#include "HAL/FileManager.h"
+#include "Serialization/StructRowSerializer.h"
 void UAtkDataManagerFunctionLibrary::WriteStringToFile(const FString& FilePath, const FString& String, bool& bOutSuccess, FString& OutInfoMessage)
 {
 	if (!FFileHelper::SaveStringToFile(String, *FilePath))
@@ -96,7 +98,79 @@ TArray<FInstancedStruct> UAtkDataManagerFunctionLibrary::GetArrayOfInstancedStru
 	return TArray<FInstancedStruct>();
 }
 
-TArray<FInstancedStruct> UAtkDataManagerFunctionLibrary::LoadCustomDataFromJson(const FString& FilePath, const UScriptStruct* structType)
+FAtkStructBuffer UAtkDataManagerFunctionLibrary::GetStructBuffer(const UDataTable* DataTable)
+{
+	if(!DataTable)
+	{
+		UE_LOG(LogUtilityModule, Error, TEXT("GetStructBuffer : Data Table is NULL"));
+		return FAtkStructBuffer();
+	}
+
+	const UScriptStruct* RowStruct = DataTable->GetRowStruct();
+	const TMap<FName, uint8*>& RowMap = DataTable->GetRowMap();
+
+	FAtkStructBuffer Buffer(RowStruct, RowMap.Num());
+	for(const auto& [Name, Ptr] : RowMap)
+	{
+		Buffer.Add(FConstStructView(RowStruct, Ptr));
+	}
+	return Buffer;
+}
+
+bool UAtkDataManagerFunctionLibrary::LoadCustomDataFromJson(const FString& FilePath, const UScriptStruct* StructType, FAtkStructBuffer& OutBuffer)
+{
+	if(!StructType)
+		return false;
+	
+	TArray<TSharedPtr<FJsonValue>> JsonArray = ReadJsonFileArray(FilePath);
+	OutBuffer.Initialize(StructType, JsonArray.Num());
+	for(const auto& JsonValue : JsonArray)
+	{
+		TSharedPtr<FJsonObject> JsonObject = JsonValue->AsObject();
+		if (!JsonObject.IsValid())
+		{
+			UE_LOG(LogUtilityModule, Error, TEXT("Invalid JSON object in array."));
+			continue;
+		}
+
+		const int32 Index = OutBuffer.AddDefaulted();
+		if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), StructType, OutBuffer.GetAt(Index).GetMemory(), 0, 0))
+		{
+			OutBuffer.RemoveAt(Index);
+		}
+	}
+	return !OutBuffer.IsEmpty();
+}
+
+bool UAtkDataManagerFunctionLibrary::LoadCustomDataFromJson(const FString& FilePath,
+	const TArray<const UScriptStruct*>& StructTypes, FAtkTypePartitionedStructArray& OutArray)
+{
+	TArray<TSharedPtr<FJsonValue>> JsonArray = ReadJsonFileArray(FilePath);
+	OutArray.Reset();
+	for(const auto& JsonValue : JsonArray)
+	{
+		TSharedPtr<FJsonObject> JsonObject = JsonValue->AsObject();
+		if (!JsonObject.IsValid())
+		{
+			UE_LOG(LogUtilityModule, Error, TEXT("Invalid JSON object in array."));
+			continue;
+		}
+
+		for(const auto& StructType : StructTypes)
+		{
+			if(!StructType || ObjectHasMissingFields(JsonObject, StructType))
+				continue;
+			
+			const int32 Index = OutArray.AddDefaulted(StructType);
+			if (FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), StructType, OutArray.GetAt(Index).GetMemory(), 0, 0))
+				break;
+			OutArray.RemoveAt(Index);
+		}
+	}
+	return !OutArray.IsEmpty();
+}
+
+TArray<FInstancedStruct> UAtkDataManagerFunctionLibrary::LoadCustomDataFromJson(const FString& FilePath, const UScriptStruct* structType, bool bRemoveDuplicates)
 {
 	TArray<TSharedPtr<FJsonValue>> JsonArray = ReadJsonFileArray(FilePath); 
 	TArray<FInstancedStruct> OutArray;
@@ -121,11 +195,15 @@ TArray<FInstancedStruct> UAtkDataManagerFunctionLibrary::LoadCustomDataFromJson(
 
 		index++;
 	}
+	if(bRemoveDuplicates)
+	{
+		UAtkStructUtilsFunctionLibrary::RemoveDuplicateStructs(OutArray);
+	}
 	return OutArray;
 }
 
 TArray<FInstancedStruct> UAtkDataManagerFunctionLibrary::LoadCustomDataFromJson(const FString& FilePath,
-                                                                             const TArray<const UScriptStruct*>& StructTypes)
+                                                                             const TArray<const UScriptStruct*>& StructTypes, bool bRemoveDuplicates)
 {
 	TArray<TSharedPtr<FJsonValue>> JsonArray = ReadJsonFileArray(FilePath); 
 	TArray<FInstancedStruct> OutArray;
@@ -150,6 +228,10 @@ TArray<FInstancedStruct> UAtkDataManagerFunctionLibrary::LoadCustomDataFromJson(
 			}
 		}
 	}
+	if(bRemoveDuplicates)
+	{
+		UAtkStructUtilsFunctionLibrary::RemoveDuplicateStructs(OutArray);
+	}
 	return OutArray;
 }
 
@@ -173,6 +255,35 @@ void UAtkDataManagerFunctionLibrary::WriteInstancedStructArrayToJson(const FStri
 	}
 }
 
+bool UAtkDataManagerFunctionLibrary::WriteInstancedStructArrayToBinary(const FString& FilePath,
+	const TArray<FInstancedStruct>& Array)
+{
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FilePath));
+	if(!FileWriter)
+	{
+		UE_LOG(LogUtilityModule, Error, TEXT("Failed to open file for writing: %s"), *FilePath);
+		return false;
+	}
+
+	FAtkStructRowWriter RowWriter(*FileWriter);
+	RowWriter.WriteAll(Array);
+	RowWriter.Finish();
+	return FileWriter->Close() && !RowWriter.IsError();
+}
+
+TArray<FInstancedStruct> UAtkDataManagerFunctionLibrary::LoadCustomDataFromBinary(const FString& FilePath)
+{
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*FilePath));
+	if(!FileReader)
+	{
+		UE_LOG(LogUtilityModule, Error, TEXT("Error loading file '%s'"), *FilePath);
+		return TArray<FInstancedStruct>();
+	}
+
+	FAtkStructRowReader RowReader(*FileReader);
+	return RowReader.ReadAll();
+}
+
 bool UAtkDataManagerFunctionLibrary::DeserializeJsonToFInstancedStruct(const TSharedPtr<FJsonObject> JsonObject, const UScriptStruct* StructType, FInstancedStruct& OutInstancedStruct)
 {
 	if(!StructType)
@@ -51,19 +51,67 @@ FInstancedStruct UAtkPropertyUtilityFunctionLibrary::GetStructFromPropertyObj(co
 
 FInstancedStruct UAtkPropertyUtilityFunctionLibrary::GetStructFromProperty(const FProperty* Property, const void* Object)
 {
-	if(!Property || !Object)
+	const FConstStructView View = GetStructViewFromProperty(Property, Object);
+	FInstancedStruct StructInstanced;
+	if(View.IsValid())
 	{
-		return FInstancedStruct();
-	}
-    
-	if(const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
-	{
-		FInstancedStruct StructInstanced;
-		const uint8* SourceData = StructProperty->ContainerPtrToValuePtr<uint8>(Object);
-		StructInstanced.Reset();
-		StructInstanced.InitializeAs(StructProperty->Struct, SourceData);
-		return StructInstanced;
+		StructInstanced.InitializeAs(View.GetScriptStruct(), View.GetMemory());
 	}
+	return StructInstanced;
+}
+
+FConstStructView UAtkPropertyUtilityFunctionLibrary::GetStructViewFromProperty(const FProperty* Property, const void* Container)
+{
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+	if(!StructProperty || !Container)
+		return FConstStructView();
+	
+	return FConstStructView(StructProperty->Struct, StructProperty->ContainerPtrToValuePtr<uint8>(Container));
+}
 
-	return FInstancedStruct();
+FStructView UAtkPropertyUtilityFunctionLibrary::GetStructViewFromProperty(const FProperty* Property, void* Container)
+{
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+	if(!StructProperty || !Container)
+		return FStructView();
+	
+	return FStructView(StructProperty->Struct, StructProperty->ContainerPtrToValuePtr<uint8>(Container));
+}
+
+FConstStructView UAtkPropertyUtilityFunctionLibrary::GetStructViewFromPropertyInstancedStruct(const FInstancedStruct& InstancedStruct,
+	const FName& PropertyName)
+{
+	if(!InstancedStruct.IsValid())
+		return FConstStructView();
+	
+	const FProperty* Property = UAtkStructUtilsFunctionLibrary::FindPropertyByName(InstancedStruct.GetScriptStruct(), PropertyName);
+	return GetStructViewFromProperty(Property, InstancedStruct.GetMemory());
+}
+
+FStructView UAtkPropertyUtilityFunctionLibrary::GetMutableStructViewFromPropertyInstancedStruct(FInstancedStruct& InstancedStruct,
+	const FName& PropertyName)
+{
+	if(!InstancedStruct.IsValid())
+		return FStructView();
+	
+	const FProperty* Property = UAtkStructUtilsFunctionLibrary::FindPropertyByName(InstancedStruct.GetScriptStruct(), PropertyName);
+	return GetStructViewFromProperty(Property, InstancedStruct.GetMutableMemory());
+}
+
+FConstStructView UAtkPropertyUtilityFunctionLibrary::GetStructViewFromPropertyObj(const UObject* Object, const FName& PropertyName)
+{
+	if(!Object)
+		return FConstStructView();
+	
+	const FProperty* Property = UAtkStructUtilsFunctionLibrary::FindPropertyByName(Object->GetClass(), PropertyName);
+	return GetStructViewFromProperty(Property, static_cast<const void*>(Object));
+}
+
+FStructView UAtkPropertyUtilityFunctionLibrary::GetMutableStructViewFromPropertyObj(UObject* Object, const FName& PropertyName)
+{
+	if(!Object)
+		return FStructView();
+	
+	const FProperty* Property = UAtkStructUtilsFunctionLibrary::FindPropertyByName(Object->GetClass(), PropertyName);
+	return GetStructViewFromProperty(Property, static_cast<void*>(Object));
 }
@@ -0,0 +1,132 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "ContainerWrappers/ArrayChangeSet.h"
+
+void FAtkArrayChangeSet::Reset()
+{
+	AddedIndices.Reset();
+	ChangedIndices.Reset();
+	RemovedIndices.Reset();
+	bReset = false;
+	SlotOrigins.Reset();
+	ChangedSlots.Reset();
+	NumOrigins = 0;
+	NumAddedSlots = 0;
+	NumChangedSlots = 0;
+}
+
+void FAtkArrayChangeSet::Finalize()
+{
+	// the elements past the tracked slots kept their place relative to each other and were not modified
+	for(int32 Index = 0; Index < SlotOrigins.Num(); ++Index)
+	{
+		if(SlotOrigins[Index] == INDEX_NONE)
+		{
+			AddedIndices.Add(Index);
+		}
+		else if(ChangedSlots[Index])
+		{
+			ChangedIndices.Add(Index);
+		}
+	}
+	RemovedIndices.Sort();
+	
+	SlotOrigins.Empty();
+	ChangedSlots.Empty();
+	NumOrigins = 0;
+	NumAddedSlots = 0;
+	NumChangedSlots = 0;
+}
+
+void FAtkArrayChangeSet::RecordInsert(int32 Index, int32 Count)
+{
+	if(bReset || Count <= 0)
+		return;
+
+	TrackSlots(Index);
+	SlotOrigins.Insert(INDEX_NONE, Index, Count);
+	ChangedSlots.Insert(false, Index, Count);
+	NumAddedSlots += Count;
+}
+
+void FAtkArrayChangeSet::RecordRemove(int32 Index)
+{
+	if(bReset)
+		return;
+
+	TrackSlots(Index + 1);
+	// an element added and removed in the same batch is not reported
+	const int32 Origin = SlotOrigins[Index];
+	if(Origin == INDEX_NONE)
+	{
+		NumAddedSlots--;
+	}
+	else
+	{
+		RemovedIndices.Add(Origin);
+		NumChangedSlots -= ChangedSlots[Index] ? 1 : 0;
+	}
+	SlotOrigins.RemoveAt(Index, 1, EAllowShrinking::No);
+	ChangedSlots.RemoveAt(Index);
+}
+
+void FAtkArrayChangeSet::RecordChange(int32 Index)
+{
+	if(bReset)
+		return;
+
+	TrackSlots(Index + 1);
+	if(SlotOrigins[Index] != INDEX_NONE && !ChangedSlots[Index])
+	{
+		ChangedSlots[Index] = true;
+		NumChangedSlots++;
+	}
+}
+
+void FAtkArrayChangeSet::RecordReset()
+{
+	Reset();
+	bReset = true;
+}
+
+void FAtkArrayChangeSet::TrackSlots(int32 Num)
+{
+	// untracked elements were not touched yet, they follow the last tracked element in their original order
+	const int32 NumToAdd = Num - SlotOrigins.Num();
+	if(NumToAdd <= 0)
+		return;
+
+	SlotOrigins.Reserve(Num);
+	for(int32 i = 0; i < NumToAdd; ++i)
+	{
+		SlotOrigins.Add(NumOrigins++);
+	}
+	ChangedSlots.Add(false, NumToAdd);
+}
+
+FAtkEndOfFrameCallback::~FAtkEndOfFrameCallback()
+{
+	Cancel();
+}
+
+bool FAtkEndOfFrameCallback::Schedule(TFunction<void()> Callback)
+{
+	if(Handle.IsValid())
+		return false;
+
+	Handle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this, Callback = MoveTemp(Callback)](float)
+	{
+		Handle.Reset();
+		Callback();
+		return false;
+	}));
+	return true;
+}
+
+void FAtkEndOfFrameCallback::Cancel()
+{
+	if(Handle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(Handle);
+		Handle.Reset();
+	}
+}
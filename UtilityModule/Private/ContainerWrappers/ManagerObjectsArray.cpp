@@ -1,5 +1,7 @@
 // Copyright 2024 An@stacioDev All rights reserved.
 #include "ContainerWrappers/ManagerObjectsArray.h"
+#include "Async/Async.h"
+#include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
 
 UTkManagerObjectsArray::UTkManagerObjectsArray(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -10,6 +12,19 @@ void UTkManagerObjectsArray::PostInitProperties()
 {
 	UObject::PostInitProperties();
 	ArrayWrapper.SetDelegates(OnObjectAdded, OnObjectRemoved, OnArraySet, OnArrayCleared);
+	ArrayWrapper.SetBatchDelegate(OnBatchCommitted);
+	ArrayWrapper.SetDeltaDelegate(OnArrayDelta);
+}
+
+void UTkManagerObjectsArray::BeginDestroy()
+{
+	EndOfFrameBatch.Cancel();
+	if(DrainTicker.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DrainTicker);
+		DrainTicker.Reset();
+	}
+	Super::BeginDestroy();
 }
 
 void UTkManagerObjectsArray::Add_BP(UObject* Object)
@@ -22,6 +37,11 @@ void UTkManagerObjectsArray::AddMultiple_BP(const TArray<UObject*>& Multiple)
 	ArrayWrapper.AddMultiple(Multiple);
 }
 
+void UTkManagerObjectsArray::AddMultiple(TArray<UObject*>&& Multiple)
+{
+	ArrayWrapper.AddMultiple(MoveTemp(Multiple));
+}
+
 bool UTkManagerObjectsArray::Remove_BP(UObject* Object)
 {
 	return ArrayWrapper.Remove(Object);
@@ -32,19 +52,67 @@ void UTkManagerObjectsArray::Clear_BP()
 	ArrayWrapper.Clear();
 }
 
+bool UTkManagerObjectsArray::RemoveAtSwap_BP(const int Index)
+{
+	return ArrayWrapper.RemoveAtSwap(Index);
+}
+
+int32 UTkManagerObjectsArray::RemoveAtIndices_BP(const TArray<int32>& Indices, bool bBroadcastItems)
+{
+	TArray<int32> ValidIndices = Indices;
+	return ArrayWrapper.RemoveAtIndices(ValidIndices, bBroadcastItems);
+}
+
+int32 UTkManagerObjectsArray::RemoveByPropertyValue_BP(const FName PropertyName, const FString& Value, bool bBroadcastItems)
+{
+	// objects of the same class usually follow each other, the property is resolved once per class
+	const UClass* CachedClass = nullptr;
+	const FProperty* CachedProperty = nullptr;
+	return RemoveAllMatching([&](const UObject* Object)
+	{
+		if(!Object)
+			return false;
+
+		if(Object->GetClass() != CachedClass)
+		{
+			CachedClass = Object->GetClass();
+			CachedProperty = CachedClass->FindPropertyByName(PropertyName);
+		}
+		return CachedProperty && UAtkStructUtilsFunctionLibrary::GetPropertyValueAsString(CachedProperty, Object) == Value;
+	});
+}
+
 TArray<UObject*> UTkManagerObjectsArray::GetArray_BP() const
 {
 	return ArrayWrapper.Get();
 }
 
+int32 UTkManagerObjectsArray::Num_BP() const
+{
+	return ArrayWrapper.Num();
+}
+
+TArray<UObject*> UTkManagerObjectsArray::GetPage_BP(int32 PageIndex, int32 PageSize) const
+{
+	if(PageIndex < 0 || PageSize <= 0 || static_cast<int64>(PageIndex) * PageSize >= ArrayWrapper.Num())
+		return TArray<UObject*>();
+	
+	return ArrayWrapper.GetRange(PageIndex * PageSize, PageSize);
+}
+
 void UTkManagerObjectsArray::SetArray_BP(const TArray<UObject*>& NewObjects)
 {
 	ArrayWrapper.Set(NewObjects);
 } 	
 
+void UTkManagerObjectsArray::SetArray(TArray<UObject*>&& NewObjects)
+{
+	ArrayWrapper.Set(MoveTemp(NewObjects));
+}
+
 void UTkManagerObjectsArray::SetAt_BP(const int Index, UObject* Object)
 {
-	if(ArrayWrapper.SetAt(Index, Object))
+	if(ArrayWrapper.SetAt(Index, Object) && ArrayWrapper.ShouldBroadcastItems())
 	{
 		OnObjectChanged.Broadcast(Object);
 	}
@@ -55,6 +123,11 @@ UObject* UTkManagerObjectsArray::At_BP(const int Index)
 	return *ArrayWrapper.At(Index);
 }
 
+bool UTkManagerObjectsArray::Swap_BP(const int FirstIndex, const int SecondIndex)
+{
+	return ArrayWrapper.Swap(FirstIndex, SecondIndex);
+}
+
 UObject* UTkManagerObjectsArray::Last_BP()
 {
 	if(ArrayWrapper.IsEmpty())
@@ -65,5 +138,138 @@ UObject* UTkManagerObjectsArray::Last_BP()
 
 bool UTkManagerObjectsArray::IsEmpty() const
 {
-	return ArrayWrapper.Get().IsEmpty();
+	return ArrayWrapper.IsEmpty();
+}
+
+void UTkManagerObjectsArray::BeginBatch()
+{
+	ArrayWrapper.BeginBatch(bBroadcastItemsInBatch);
+}
+
+void UTkManagerObjectsArray::EndBatch()
+{
+	ArrayWrapper.EndBatch();
+}
+
+void UTkManagerObjectsArray::BatchUntilEndOfFrame()
+{
+	if(EndOfFrameBatch.Schedule([WeakThis = TWeakObjectPtr<UTkManagerObjectsArray>(this)]()
+	{
+		if(WeakThis.IsValid())
+		{
+			WeakThis->EndBatch();
+		}
+	}))
+	{
+		BeginBatch();
+	}
+}
+
+bool UTkManagerObjectsArray::IsInBatch() const
+{
+	return ArrayWrapper.IsInBatch();
+}
+
+void UTkManagerObjectsArray::EnqueueAdd(UObject* Object)
+{
+	if(CommandQueue.EnqueueAdd(Object))
+		ScheduleDrain();
+}
+
+void UTkManagerObjectsArray::EnqueueRemove(UObject* Object)
+{
+	if(CommandQueue.EnqueueRemove(Object))
+		ScheduleDrain();
+}
+
+void UTkManagerObjectsArray::EnqueueSetAt(int32 Index, UObject* Object)
+{
+	if(CommandQueue.EnqueueSetAt(Index, Object))
+		ScheduleDrain();
+}
+
+void UTkManagerObjectsArray::EnqueueSetArray(TArray<UObject*> NewObjects)
+{
+	if(CommandQueue.EnqueueSetArray(MoveTemp(NewObjects)))
+		ScheduleDrain();
+}
+
+void UTkManagerObjectsArray::EnqueueClear()
+{
+	if(CommandQueue.EnqueueClear())
+		ScheduleDrain();
+}
+
+void UTkManagerObjectsArray::FlushQueue()
+{
+	if(!DrainQueue(TNumericLimits<double>::Max()))
+	{
+		StartDraining();
+	}
+}
+
+void UTkManagerObjectsArray::ScheduleDrain()
+{
+	if(IsInGameThread())
+	{
+		StartDraining();
+		return;
+	}
+	// one task per burst of edits, the edits themselves go through the queue
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UTkManagerObjectsArray>(this)]()
+	{
+		if(WeakThis.IsValid())
+		{
+			WeakThis->StartDraining();
+		}
+	});
+}
+
+void UTkManagerObjectsArray::StartDraining()
+{
+	if(DrainTicker.IsValid())
+		return;
+
+	DrainTicker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+	{
+		if(DrainQueue(QueueDrainBudgetMs / 1000.0))
+		{
+			DrainTicker.Reset();
+			return false;
+		}
+		return true;
+	}));
+}
+
+bool UTkManagerObjectsArray::DrainQueue(double BudgetSeconds)
+{
+	BeginBatch();
+	const bool bEmpty = CommandQueue.Drain(BudgetSeconds, [this](FCommandQueue::FCommand& Command)
+	{
+		ApplyCommand(Command);
+	});
+	EndBatch();
+	return bEmpty;
+}
+
+void UTkManagerObjectsArray::ApplyCommand(FCommandQueue::FCommand& Command)
+{
+	switch(Command.Type)
+	{
+	case FCommandQueue::ECommandType::Add:
+		Add_BP(Command.Value);
+		break;
+	case FCommandQueue::ECommandType::Remove:
+		Remove_BP(Command.Value);
+		break;
+	case FCommandQueue::ECommandType::SetAt:
+		SetAt_BP(Command.Index, Command.Value);
+		break;
+	case FCommandQueue::ECommandType::SetArray:
+		SetArray(MoveTemp(Command.Values));
+		break;
+	case FCommandQueue::ECommandType::Clear:
+		Clear_BP();
+		break;
+	}
 }
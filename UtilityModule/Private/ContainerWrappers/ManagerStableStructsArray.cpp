@@ -0,0 +1,95 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "ContainerWrappers/ManagerStableStructsArray.h"
+#include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
+
+FAtkStructHandle UTkManagerStableStructsArray::Add_BP(const FInstancedStruct& DataStruct)
+{
+	const FAtkStructHandle Handle = Structs.Emplace(DataStruct);
+	OnStructAdded.Broadcast(Handle, *Structs.Find(Handle));
+	return Handle;
+}
+
+FAtkStructHandle UTkManagerStableStructsArray::Add(FInstancedStruct&& DataStruct)
+{
+	const FAtkStructHandle Handle = Structs.Emplace(MoveTemp(DataStruct));
+	OnStructAdded.Broadcast(Handle, *Structs.Find(Handle));
+	return Handle;
+}
+
+FAtkStructHandle UTkManagerStableStructsArray::InsertBefore_BP(const FAtkStructHandle& Before, const FInstancedStruct& DataStruct)
+{
+	const FAtkStructHandle Handle = Structs.EmplaceBefore(Before, DataStruct);
+	if(Handle.IsSet())
+	{
+		OnStructAdded.Broadcast(Handle, *Structs.Find(Handle));
+	}
+	return Handle;
+}
+
+bool UTkManagerStableStructsArray::Remove_BP(const FAtkStructHandle& Handle)
+{
+	FInstancedStruct* Found = Structs.Find(Handle);
+	if(!Found)
+		return false;
+
+	const FInstancedStruct Removed = MoveTemp(*Found);
+	Structs.Remove(Handle);
+	OnStructRemoved.Broadcast(Handle, Removed);
+	return true;
+}
+
+void UTkManagerStableStructsArray::Clear_BP()
+{
+	Structs.Empty();
+	OnArrayCleared.Broadcast();
+}
+
+bool UTkManagerStableStructsArray::IsValidHandle(const FAtkStructHandle& Handle) const
+{
+	return Structs.IsValid(Handle);
+}
+
+FInstancedStruct UTkManagerStableStructsArray::Get_BP(const FAtkStructHandle& Handle, bool& bFound) const
+{
+	const FInstancedStruct* Found = Structs.Find(Handle);
+	bFound = Found != nullptr;
+	return Found ? *Found : FInstancedStruct();
+}
+
+bool UTkManagerStableStructsArray::Set_BP(const FAtkStructHandle& Handle, const FInstancedStruct& NewStruct)
+{
+	FInstancedStruct* Found = Structs.Find(Handle);
+	if(!Found || UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual(*Found, NewStruct))
+		return false;
+
+	*Found = NewStruct;
+	OnStructChanged.Broadcast(Handle, *Found);
+	return true;
+}
+
+int32 UTkManagerStableStructsArray::Num_BP() const
+{
+	return Structs.Num();
+}
+
+TArray<FInstancedStruct> UTkManagerStableStructsArray::GetArray_BP() const
+{
+	TArray<FInstancedStruct> Result;
+	Result.Reserve(Structs.Num());
+	Structs.ForEach([&Result](const FAtkStructHandle&, const FInstancedStruct& Struct)
+	{
+		Result.Add(Struct);
+	});
+	return Result;
+}
+
+TArray<FAtkStructHandle> UTkManagerStableStructsArray::GetHandles_BP() const
+{
+	TArray<FAtkStructHandle> Result;
+	Result.Reserve(Structs.Num());
+	Structs.ForEach([&Result](const FAtkStructHandle& Handle, const FInstancedStruct&)
+	{
+		Result.Add(Handle);
+	});
+	return Result;
+}
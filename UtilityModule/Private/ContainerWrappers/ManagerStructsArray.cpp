@@ -1,5 +1,77 @@
 // Copyright 2024 An@stacioDev All rights reserved.
 #include "ContainerWrappers/ManagerStructsArray.h"
+#include "Async/Async.h"
+#include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
+
+namespace
+{
+	// Calls Func(Index, Count) for every run of consecutive valid indices, from the back so every index is still right when
+	// the runs are removed in that order
+	template<typename FuncType>
+	void ForEachRemovedRun(TConstArrayView<int32> SortedIndices, int32 Num, FuncType&& Func)
+	{
+		TArray<int32> Removed;
+		for(const int32 Index : SortedIndices)
+		{
+			if(Index >= 0 && Index < Num && (Removed.IsEmpty() || Removed.Last() != Index))
+				Removed.Add(Index);
+		}
+
+		for(int32 RunEnd = Removed.Num() - 1; RunEnd >= 0;)
+		{
+			int32 RunStart = RunEnd;
+			while(RunStart > 0 && Removed[RunStart - 1] == Removed[RunStart] - 1)
+			{
+				--RunStart;
+			}
+			Func(Removed[RunStart], RunEnd - RunStart + 1);
+			RunEnd = RunStart - 1;
+		}
+	}
+}
+
+// Applies the edits of the history through the manager so the hashes and events stay right
+class FAtkStructsArrayHistoryTarget : public FAtkStructArrayHistory::IEditTarget
+{
+public:
+	explicit FAtkStructsArrayHistoryTarget(UTkManagerStructsArray& InManager)
+		: Manager(InManager)
+	{}
+
+	virtual const FInstancedStruct* GetAt(int32 Index) const override
+	{
+		const TConstArrayView<FInstancedStruct> View = Manager.GetView();
+		return View.IsValidIndex(Index) ? &View[Index] : nullptr;
+	}
+
+	virtual void InsertAt(int32 Index, TConstArrayView<FInstancedStruct> Structs) override
+	{
+		Manager.InsertStructsAt(Index, Structs);
+	}
+
+	virtual void RemoveAt(int32 Index, int32 Count) override
+	{
+		Manager.RemoveStructsAt(Index, Count);
+	}
+
+	virtual void Swap(int32 FirstIndex, int32 SecondIndex) override
+	{
+		Manager.Swap_BP(FirstIndex, SecondIndex);
+	}
+
+	virtual void SetAt(int32 Index, FInstancedStruct&& Struct) override
+	{
+		Manager.SetAt(Index, Struct);
+	}
+
+	virtual void SetArray(const TArray<FInstancedStruct>& Structs) override
+	{
+		Manager.SetArray_BP(Structs);
+	}
+
+private:
+	UTkManagerStructsArray& Manager;
+};
 
 UTkManagerStructsArray::UTkManagerStructsArray(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -10,26 +82,218 @@ void UTkManagerStructsArray::PostInitProperties()
 {
 	UObject::PostInitProperties();
 	ArrayWrapper.SetDelegates(OnStructAdded, OnStructRemoved, OnArraySet, OnArrayCleared);
+	ArrayWrapper.SetBatchDelegate(OnBatchCommitted);
+	ArrayWrapper.SetDeltaDelegate(OnArrayDelta);
+#if WITH_EDITOR
+	if(!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		SetFlags(RF_Transactional);
+	}
+#endif
+}
+
+void UTkManagerStructsArray::BeginDestroy()
+{
+	EndOfFrameBatch.Cancel();
+	if(DrainTicker.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DrainTicker);
+		DrainTicker.Reset();
+	}
+	CloseJournal();
+	Super::BeginDestroy();
 }
 
 void UTkManagerStructsArray::Add_BP(const FInstancedStruct& DataStruct)
 {
+	if(!ElementHashes.IsEmpty())
+	{
+		ElementHashes.Add(0);
+	}
 	ArrayWrapper.Add(DataStruct);
+	RecordHistory([this](FAtkStructArrayHistory& InHistory)
+	{
+		InHistory.RecordInsert(ArrayWrapper.Num() - 1, MakeArrayView(&ArrayWrapper.GetRef().Last(), 1));
+	});
+	RecordJournal([this](FAtkStructArrayJournal& InJournal)
+	{
+		InJournal.AppendInsert(ArrayWrapper.Num() - 1, MakeArrayView(&ArrayWrapper.GetRef().Last(), 1));
+	});
 }
 
 void UTkManagerStructsArray::AddMultiple_BP(const TArray<FInstancedStruct>& DataStructs)
 {
+	if(!ElementHashes.IsEmpty())
+	{
+		ElementHashes.AddZeroed(DataStructs.Num());
+	}
+	const int32 FirstIndex = ArrayWrapper.Num();
 	ArrayWrapper.AddMultiple(DataStructs);
+	RecordHistory([this, FirstIndex](FAtkStructArrayHistory& InHistory)
+	{
+		InHistory.RecordInsert(FirstIndex, ArrayWrapper.GetView().RightChop(FirstIndex));
+	});
+	RecordJournal([this, FirstIndex](FAtkStructArrayJournal& InJournal)
+	{
+		InJournal.AppendInsert(FirstIndex, ArrayWrapper.GetView().RightChop(FirstIndex));
+	});
+}
+
+void UTkManagerStructsArray::Add(FInstancedStruct&& DataStruct)
+{
+	if(!ElementHashes.IsEmpty())
+	{
+		ElementHashes.Add(0);
+	}
+	ArrayWrapper.Add(MoveTemp(DataStruct));
+	RecordHistory([this](FAtkStructArrayHistory& InHistory)
+	{
+		InHistory.RecordInsert(ArrayWrapper.Num() - 1, MakeArrayView(&ArrayWrapper.GetRef().Last(), 1));
+	});
+	RecordJournal([this](FAtkStructArrayJournal& InJournal)
+	{
+		InJournal.AppendInsert(ArrayWrapper.Num() - 1, MakeArrayView(&ArrayWrapper.GetRef().Last(), 1));
+	});
+}
+
+void UTkManagerStructsArray::AddMultiple(TArray<FInstancedStruct>&& DataStructs)
+{
+	if(!ElementHashes.IsEmpty())
+	{
+		ElementHashes.AddZeroed(DataStructs.Num());
+	}
+	const int32 FirstIndex = ArrayWrapper.Num();
+	ArrayWrapper.AddMultiple(MoveTemp(DataStructs));
+	RecordHistory([this, FirstIndex](FAtkStructArrayHistory& InHistory)
+	{
+		InHistory.RecordInsert(FirstIndex, ArrayWrapper.GetView().RightChop(FirstIndex));
+	});
+	RecordJournal([this, FirstIndex](FAtkStructArrayJournal& InJournal)
+	{
+		InJournal.AppendInsert(FirstIndex, ArrayWrapper.GetView().RightChop(FirstIndex));
+	});
 }
 
 void UTkManagerStructsArray::Remove_BP(const FInstancedStruct& DataStruct)
 {
-	ArrayWrapper.Remove(DataStruct);
+	const int32 Index = FindIndex(DataStruct);
+	if(Index != INDEX_NONE)
+	{
+		RecordHistory([this, Index](FAtkStructArrayHistory& InHistory)
+		{
+			InHistory.RecordRemove(Index, ArrayWrapper.GetView().Slice(Index, 1));
+		});
+		ElementHashes.RemoveAt(Index);
+		ArrayWrapper.RemoveAt(Index);
+		RecordJournal([Index](FAtkStructArrayJournal& InJournal)
+		{
+			InJournal.AppendRemove(Index, 1);
+		});
+	}
 }
 
 void UTkManagerStructsArray::Clear_BP()
 {
+	const FAtkStructArrayHistory::FArraySnapshot OldStructs = ArrayWrapper.GetSnapshot();
+	InvalidateHashes();
 	ArrayWrapper.Clear();
+	if(!OldStructs->IsEmpty())
+	{
+		RecordHistory([this, &OldStructs](FAtkStructArrayHistory& InHistory)
+		{
+			InHistory.RecordSetArray(OldStructs, ArrayWrapper.GetSnapshot());
+		});
+		CompactJournal();
+	}
+}
+
+bool UTkManagerStructsArray::RemoveAtSwap_BP(const int Index)
+{
+	if(!ArrayWrapper.ValidIndex(Index))
+		return false;
+
+	RecordHistory([this, Index](FAtkStructArrayHistory& InHistory)
+	{
+		// same as moving the last struct into Index then removing the last one
+		const int32 LastIndex = ArrayWrapper.Num() - 1;
+		InHistory.BeginTransaction();
+		if(Index != LastIndex)
+		{
+			InHistory.RecordSwap(Index, LastIndex);
+		}
+		InHistory.RecordRemove(LastIndex, ArrayWrapper.GetView().Slice(Index, 1));
+		InHistory.EndTransaction();
+	});
+	if(!ElementHashes.IsEmpty())
+	{
+		ElementHashes.RemoveAtSwap(Index);
+	}
+	const int32 LastIndex = ArrayWrapper.Num() - 1;
+	const bool bRemoved = ArrayWrapper.RemoveAtSwap(Index);
+	RecordJournal([Index, LastIndex](FAtkStructArrayJournal& InJournal)
+	{
+		if(Index != LastIndex)
+		{
+			InJournal.AppendSwap(Index, LastIndex);
+		}
+		InJournal.AppendRemove(LastIndex, 1);
+	});
+	return bRemoved;
+}
+
+int32 UTkManagerStructsArray::RemoveAtIndices_BP(const TArray<int32>& Indices, bool bBroadcastItems)
+{
+	TArray<int32> SortedIndices = Indices;
+	SortedIndices.Sort();
+	return RemoveAtSortedIndices(SortedIndices, bBroadcastItems);
+}
+
+int32 UTkManagerStructsArray::RemoveByPropertyValue_BP(const FString& PropertyName, const FString& Value, bool bBroadcastItems)
+{
+	TArray<int32> Indices = UAtkStructUtilsFunctionLibrary::FindStructsWithPropertyValue(ArrayWrapper.GetView(), PropertyName, Value);
+	return RemoveAtSortedIndices(Indices, bBroadcastItems);
+}
+
+int32 UTkManagerStructsArray::RemoveAtSortedIndices(TArray<int32>& Indices, bool bBroadcastItems)
+{
+	RecordHistory([this, &Indices](FAtkStructArrayHistory& InHistory)
+	{
+		const TConstArrayView<FInstancedStruct> View = ArrayWrapper.GetView();
+		InHistory.BeginTransaction();
+		ForEachRemovedRun(Indices, View.Num(), [&InHistory, &View](int32 Index, int32 Count)
+		{
+			InHistory.RecordRemove(Index, View.Slice(Index, Count));
+		});
+		InHistory.EndTransaction();
+	});
+
+	// the hashes are compacted first so FindIndex is right while the removal is broadcast
+	if(!ElementHashes.IsEmpty())
+	{
+		int32 Write = 0;
+		int32 NextRemoved = 0;
+		for(int32 Read = 0; Read < ElementHashes.Num(); ++Read)
+		{
+			while(NextRemoved < Indices.Num() && Indices[NextRemoved] < Read)
+			{
+				++NextRemoved;
+			}
+			if(NextRemoved < Indices.Num() && Indices[NextRemoved] == Read)
+				continue;
+			ElementHashes[Write++] = ElementHashes[Read];
+		}
+		ElementHashes.SetNum(Write);
+	}
+	const int32 NumBefore = ArrayWrapper.Num();
+	const int32 NumRemoved = ArrayWrapper.RemoveAtIndices(Indices, bBroadcastItems);
+	RecordJournal([&Indices, NumBefore](FAtkStructArrayJournal& InJournal)
+	{
+		ForEachRemovedRun(Indices, NumBefore, [&InJournal](int32 Index, int32 Count)
+		{
+			InJournal.AppendRemove(Index, Count);
+		});
+	});
+	return NumRemoved;
 }
 
 TArray<FInstancedStruct> UTkManagerStructsArray::GetArray_BP() const
@@ -37,13 +301,47 @@ TArray<FInstancedStruct> UTkManagerStructsArray::GetArray_BP() const
 	return ArrayWrapper.Get();
 }
 
+int32 UTkManagerStructsArray::Num_BP() const
+{
+	return ArrayWrapper.Num();
+}
+
+TArray<FInstancedStruct> UTkManagerStructsArray::GetPage_BP(int32 PageIndex, int32 PageSize) const
+{
+	if(PageIndex < 0 || PageSize <= 0 || static_cast<int64>(PageIndex) * PageSize >= ArrayWrapper.Num())
+		return TArray<FInstancedStruct>();
+	
+	return ArrayWrapper.GetRange(PageIndex * PageSize, PageSize);
+}
+
 void UTkManagerStructsArray::SetArray_BP(const TArray<FInstancedStruct>& NewStructs)
 {
+	const FAtkStructArrayHistory::FArraySnapshot OldStructs = ArrayWrapper.GetSnapshot();
+	InvalidateHashes();
 	ArrayWrapper.Set(NewStructs);
+	RecordHistory([this, &OldStructs](FAtkStructArrayHistory& InHistory)
+	{
+		InHistory.RecordSetArray(OldStructs, ArrayWrapper.GetSnapshot());
+	});
+	CompactJournal();
+}
+
+void UTkManagerStructsArray::SetArray(TArray<FInstancedStruct>&& NewStructs)
+{
+	const FAtkStructArrayHistory::FArraySnapshot OldStructs = ArrayWrapper.GetSnapshot();
+	InvalidateHashes();
+	ArrayWrapper.Set(MoveTemp(NewStructs));
+	RecordHistory([this, &OldStructs](FAtkStructArrayHistory& InHistory)
+	{
+		InHistory.RecordSetArray(OldStructs, ArrayWrapper.GetSnapshot());
+	});
+	CompactJournal();
 }
 
 FInstancedStruct& UTkManagerStructsArray::At_BP(const int Index)
 {
+	// the reference can be used to modify the struct
+	InvalidateHash(Index);
 	return *ArrayWrapper.At(Index);
 }
 
@@ -52,10 +350,360 @@ void UTkManagerStructsArray::SetAt(const int Index, const FInstancedStruct& NewS
 	if(!ArrayWrapper.ValidIndex(Index))
 		return;
 
-	const FInstancedStruct Prev = *ArrayWrapper.At(Index);
-	if(ArrayWrapper.SetAt(Index, NewStruct))
+	const FInstancedStruct Prev = ArrayWrapper.GetView()[Index];
+	if(ArrayWrapper.SetAt(Index, NewStruct, &UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual))
 	{
+		InvalidateHash(Index);
+		RecordHistory([&](FAtkStructArrayHistory& InHistory)
+		{
+			InHistory.RecordSet(Index, Prev, NewStruct);
+		});
+		RecordJournal([&](FAtkStructArrayJournal& InJournal)
+		{
+			InJournal.AppendSet(Index, Prev, NewStruct);
+		});
+		if(!ArrayWrapper.ShouldBroadcastItems())
+			return;
+		
 		OnStructChanged.Broadcast(Prev, NewStruct);
+		if(OnStructPropertiesChanged.IsBound())
+		{
+			OnStructPropertiesChanged.Broadcast(Index, NewStruct, UAtkStructUtilsFunctionLibrary::GetChangedPropertyPaths(Prev, NewStruct));
+		}
+	}
+}
+
+bool UTkManagerStructsArray::Swap_BP(const int FirstIndex, const int SecondIndex)
+{
+	if(!ArrayWrapper.Swap(FirstIndex, SecondIndex))
+		return false;
+
+	if(!ElementHashes.IsEmpty())
+	{
+		ElementHashes.Swap(FirstIndex, SecondIndex);
+	}
+	RecordHistory([FirstIndex, SecondIndex](FAtkStructArrayHistory& InHistory)
+	{
+		InHistory.RecordSwap(FirstIndex, SecondIndex);
+	});
+	RecordJournal([FirstIndex, SecondIndex](FAtkStructArrayJournal& InJournal)
+	{
+		InJournal.AppendSwap(FirstIndex, SecondIndex);
+	});
+	return true;
+}
+
+bool UTkManagerStructsArray::Undo()
+{
+	if(!History.CanUndo())
+		return false;
+
+#if WITH_EDITOR
+	Modify();
+#endif
+	MoveHistoryTo(History.GetPosition() - 1);
+	return true;
+}
+
+bool UTkManagerStructsArray::Redo()
+{
+	if(!History.CanRedo())
+		return false;
+
+#if WITH_EDITOR
+	Modify();
+#endif
+	MoveHistoryTo(History.GetPosition() + 1);
+	return true;
+}
+
+bool UTkManagerStructsArray::CanUndo() const
+{
+	return History.CanUndo();
+}
+
+bool UTkManagerStructsArray::CanRedo() const
+{
+	return History.CanRedo();
+}
+
+void UTkManagerStructsArray::ClearHistory()
+{
+	History.Reset();
+}
+
+void UTkManagerStructsArray::BeginEditTransaction()
+{
+	History.BeginTransaction();
+}
+
+void UTkManagerStructsArray::EndEditTransaction()
+{
+	History.EndTransaction();
+}
+
+#if WITH_EDITOR
+void UTkManagerStructsArray::PostEditUndo()
+{
+	Super::PostEditUndo();
+	MoveHistoryTo(HistoryCursor);
+}
+#endif
+
+void UTkManagerStructsArray::MoveHistoryTo(int32 Position)
+{
+	FAtkStructsArrayHistoryTarget Target(*this);
+	TGuardValue<bool> ApplyingHistory(bApplyingHistory, true);
+	BeginBatch();
+	while(History.GetPosition() > Position && History.Undo(Target))
+	{
+	}
+	while(History.GetPosition() < Position && History.Redo(Target))
+	{
+	}
+	EndBatch();
+#if WITH_EDITORONLY_DATA
+	HistoryCursor = History.GetPosition();
+#endif
+}
+
+void UTkManagerStructsArray::InsertStructsAt(int32 Index, TConstArrayView<FInstancedStruct> Structs)
+{
+	for(int32 i = 0; i < Structs.Num(); ++i)
+	{
+		if(!ElementHashes.IsEmpty())
+		{
+			ElementHashes.Insert(0, Index + i);
+		}
+		ArrayWrapper.InsertAt(Index + i, Structs[i]);
+	}
+	RecordJournal([Index, Structs](FAtkStructArrayJournal& InJournal)
+	{
+		InJournal.AppendInsert(Index, Structs);
+	});
+}
+
+void UTkManagerStructsArray::RemoveStructsAt(int32 Index, int32 Count)
+{
+	TArray<int32> Indices;
+	Indices.Reserve(Count);
+	for(int32 i = 0; i < Count; ++i)
+	{
+		Indices.Add(Index + i);
+	}
+	RemoveAtSortedIndices(Indices);
+}
+
+bool UTkManagerStructsArray::OpenJournal(const FString& BasePath, bool bLoad)
+{
+	CloseJournal();
+	if(bLoad)
+	{
+		TArray<FInstancedStruct> Loaded;
+		if(!FAtkStructArrayJournal::Load(BasePath, Loaded))
+			return false;
+
+		SetArray(MoveTemp(Loaded));
+	}
+	// starts from a snapshot of the current structs, what was saved before is replaced
+	Journal = MakeUnique<FAtkStructArrayJournal>(BasePath, ArrayWrapper.GetSnapshot());
+	return true;
+}
+
+void UTkManagerStructsArray::CloseJournal()
+{
+	Journal.Reset();
+}
+
+void UTkManagerStructsArray::CompactJournal()
+{
+	if(Journal)
+	{
+		Journal->Compact(ArrayWrapper.GetSnapshot());
+	}
+}
+
+void UTkManagerStructsArray::FlushJournal()
+{
+	if(Journal)
+	{
+		Journal->Flush();
+	}
+}
+
+bool UTkManagerStructsArray::IsJournalOpen() const
+{
+	return Journal.IsValid();
+}
+
+void UTkManagerStructsArray::BeginBatch()
+{
+	ArrayWrapper.BeginBatch(bBroadcastItemsInBatch);
+}
+
+void UTkManagerStructsArray::EndBatch()
+{
+	ArrayWrapper.EndBatch();
+}
+
+void UTkManagerStructsArray::BatchUntilEndOfFrame()
+{
+	if(EndOfFrameBatch.Schedule([WeakThis = TWeakObjectPtr<UTkManagerStructsArray>(this)]()
+	{
+		if(WeakThis.IsValid())
+		{
+			WeakThis->EndBatch();
+		}
+	}))
+	{
+		BeginBatch();
+	}
+}
+
+bool UTkManagerStructsArray::IsInBatch() const
+{
+	return ArrayWrapper.IsInBatch();
+}
+
+int32 UTkManagerStructsArray::FindIndex(const FInstancedStruct& DataStruct) const
+{
+	const TArray<FInstancedStruct>& Array = ArrayWrapper.GetRef();
+	if(ElementHashes.Num() != Array.Num())
+	{
+		ElementHashes.Reset();
+		ElementHashes.SetNumZeroed(Array.Num());
 	}
 	
+	const uint64 Hash = UAtkStructUtilsFunctionLibrary::HashStruct(DataStruct.GetScriptStruct(), DataStruct.GetMemory());
+	for(int32 Index = 0; Index < Array.Num(); ++Index)
+	{
+		uint64& ElementHash = ElementHashes[Index];
+		if(ElementHash == 0)
+		{
+			ElementHash = UAtkStructUtilsFunctionLibrary::HashStruct(Array[Index].GetScriptStruct(), Array[Index].GetMemory());
+		}
+		// equal hashes are confirmed with a full compare
+		if(ElementHash == Hash && UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual(Array[Index], DataStruct))
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void UTkManagerStructsArray::InvalidateHashes()
+{
+	ElementHashes.Reset();
+}
+
+void UTkManagerStructsArray::InvalidateHash(int32 Index)
+{
+	if(ElementHashes.IsValidIndex(Index))
+	{
+		ElementHashes[Index] = 0;
+	}
+}
+
+void UTkManagerStructsArray::EnqueueAdd(FInstancedStruct DataStruct)
+{
+	if(CommandQueue.EnqueueAdd(MoveTemp(DataStruct)))
+		ScheduleDrain();
+}
+
+void UTkManagerStructsArray::EnqueueRemove(FInstancedStruct DataStruct)
+{
+	if(CommandQueue.EnqueueRemove(MoveTemp(DataStruct)))
+		ScheduleDrain();
+}
+
+void UTkManagerStructsArray::EnqueueSetAt(int32 Index, FInstancedStruct NewStruct)
+{
+	if(CommandQueue.EnqueueSetAt(Index, MoveTemp(NewStruct)))
+		ScheduleDrain();
+}
+
+void UTkManagerStructsArray::EnqueueSetArray(TArray<FInstancedStruct> NewStructs)
+{
+	if(CommandQueue.EnqueueSetArray(MoveTemp(NewStructs)))
+		ScheduleDrain();
+}
+
+void UTkManagerStructsArray::EnqueueClear()
+{
+	if(CommandQueue.EnqueueClear())
+		ScheduleDrain();
+}
+
+void UTkManagerStructsArray::FlushQueue()
+{
+	if(!DrainQueue(TNumericLimits<double>::Max()))
+	{
+		StartDraining();
+	}
+}
+
+void UTkManagerStructsArray::ScheduleDrain()
+{
+	if(IsInGameThread())
+	{
+		StartDraining();
+		return;
+	}
+	// one task per burst of edits, the edits themselves go through the queue
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UTkManagerStructsArray>(this)]()
+	{
+		if(WeakThis.IsValid())
+		{
+			WeakThis->StartDraining();
+		}
+	});
+}
+
+void UTkManagerStructsArray::StartDraining()
+{
+	if(DrainTicker.IsValid())
+		return;
+
+	DrainTicker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+	{
+		if(DrainQueue(QueueDrainBudgetMs / 1000.0))
+		{
+			DrainTicker.Reset();
+			return false;
+		}
+		return true;
+	}));
+}
+
+bool UTkManagerStructsArray::DrainQueue(double BudgetSeconds)
+{
+	BeginBatch();
+	const bool bEmpty = CommandQueue.Drain(BudgetSeconds, [this](FCommandQueue::FCommand& Command)
+	{
+		ApplyCommand(Command);
+	});
+	EndBatch();
+	return bEmpty;
+}
+
+void UTkManagerStructsArray::ApplyCommand(FCommandQueue::FCommand& Command)
+{
+	switch(Command.Type)
+	{
+	case FCommandQueue::ECommandType::Add:
+		Add(MoveTemp(Command.Value));
+		break;
+	case FCommandQueue::ECommandType::Remove:
+		Remove_BP(Command.Value);
+		break;
+	case FCommandQueue::ECommandType::SetAt:
+		SetAt(Command.Index, Command.Value);
+		break;
+	case FCommandQueue::ECommandType::SetArray:
+		SetArray(MoveTemp(Command.Values));
+		break;
+	case FCommandQueue::ECommandType::Clear:
+		Clear_BP();
+		break;
+	}
 }
@@ -0,0 +1,138 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "ContainerWrappers/SharedDefaultStructArray.h"
+#include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
+
+FAtkSharedDefaultStructArray::FAtkSharedDefaultStructArray(int32 Num, const FInstancedStruct& InDefault)
+{
+	Init(Num, InDefault);
+}
+
+void FAtkSharedDefaultStructArray::Init(int32 Num, const FInstancedStruct& InDefault)
+{
+	Default = InDefault;
+	Elements.Reset();
+	Elements.SetNum(FMath::Max(Num, 0));
+	NumOwnedElements = 0;
+}
+
+void FAtkSharedDefaultStructArray::InitFromArray(TArray<FInstancedStruct>&& Array, const FInstancedStruct& InDefault)
+{
+	Default = InDefault;
+	Elements = MoveTemp(Array);
+	NumOwnedElements = Elements.Num();
+	for(FInstancedStruct& Element : Elements)
+	{
+		if(!Element.IsValid() || UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual(Element, Default))
+		{
+			Element.Reset();
+			NumOwnedElements--;
+		}
+	}
+}
+
+FConstStructView FAtkSharedDefaultStructArray::Get(int32 Index) const
+{
+	const FInstancedStruct& Element = Elements[Index];
+	return Element.IsValid() ? FConstStructView(Element.GetScriptStruct(), Element.GetMemory()) : FConstStructView(Default.GetScriptStruct(), Default.GetMemory());
+}
+
+const UScriptStruct* FAtkSharedDefaultStructArray::GetScriptStruct(int32 Index) const
+{
+	const FInstancedStruct& Element = Elements[Index];
+	return Element.IsValid() ? Element.GetScriptStruct() : Default.GetScriptStruct();
+}
+
+FStructView FAtkSharedDefaultStructArray::GetMutable(int32 Index)
+{
+	FInstancedStruct& Element = Elements[Index];
+	if(!Element.IsValid())
+	{
+		if(!Default.IsValid())
+			return FStructView();
+		
+		Element = Default;
+		NumOwnedElements++;
+	}
+	return FStructView(Element.GetScriptStruct(), Element.GetMutableMemory());
+}
+
+void FAtkSharedDefaultStructArray::Set(int32 Index, const FInstancedStruct& Value)
+{
+	// an invalid element means shared, an invalid value is stored as the default instead of an owned empty payload
+	if(!Value.IsValid() || UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual(Value, Default))
+	{
+		ResetToDefault(Index);
+		return;
+	}
+	
+	FInstancedStruct& Element = Elements[Index];
+	if(!Element.IsValid())
+	{
+		NumOwnedElements++;
+	}
+	Element = Value;
+}
+
+void FAtkSharedDefaultStructArray::Set(int32 Index, FInstancedStruct&& Value)
+{
+	// an invalid element means shared, an invalid value is stored as the default instead of an owned empty payload
+	if(!Value.IsValid() || UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual(Value, Default))
+	{
+		ResetToDefault(Index);
+		return;
+	}
+	
+	FInstancedStruct& Element = Elements[Index];
+	if(!Element.IsValid())
+	{
+		NumOwnedElements++;
+	}
+	Element = MoveTemp(Value);
+}
+
+void FAtkSharedDefaultStructArray::AddDefault()
+{
+	Elements.AddDefaulted();
+}
+
+void FAtkSharedDefaultStructArray::Add(const FInstancedStruct& Value)
+{
+	Elements.AddDefaulted();
+	Set(Elements.Num() - 1, Value);
+}
+
+void FAtkSharedDefaultStructArray::RemoveAt(int32 Index)
+{
+	if(!IsShared(Index))
+	{
+		NumOwnedElements--;
+	}
+	Elements.RemoveAt(Index);
+}
+
+void FAtkSharedDefaultStructArray::ResetToDefault(int32 Index)
+{
+	FInstancedStruct& Element = Elements[Index];
+	if(Element.IsValid())
+	{
+		Element.Reset();
+		NumOwnedElements--;
+	}
+}
+
+void FAtkSharedDefaultStructArray::Empty()
+{
+	Elements.Empty();
+	NumOwnedElements = 0;
+}
+
+TArray<FInstancedStruct> FAtkSharedDefaultStructArray::ToArray() const
+{
+	TArray<FInstancedStruct> Array;
+	Array.Reserve(Elements.Num());
+	for(const FInstancedStruct& Element : Elements)
+	{
+		Array.Add(Element.IsValid() ? Element : Default);
+	}
+	return Array;
+}
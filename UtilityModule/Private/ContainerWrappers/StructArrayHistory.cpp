@@ -0,0 +1,273 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "ContainerWrappers/StructArrayHistory.h"
+#include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
+#include "Reflection/StructLayout.h"
+
+FAtkStructArrayHistory::FPropertyDelta::FPropertyDelta(const FProperty* InProperty, const void* OldContainer, const void* NewContainer)
+	: Property(InProperty)
+{
+	const int32 ValueOffset = Align(Property->GetSize(), Property->GetMinAlignment());
+	Values = static_cast<uint8*>(FMemory::Malloc(ValueOffset * 2, Property->GetMinAlignment()));
+	Property->InitializeValue(Values);
+	Property->InitializeValue(Values + ValueOffset);
+	Property->CopyCompleteValue(Values, Property->ContainerPtrToValuePtr<void>(OldContainer));
+	Property->CopyCompleteValue(Values + ValueOffset, Property->ContainerPtrToValuePtr<void>(NewContainer));
+}
+
+FAtkStructArrayHistory::FPropertyDelta::FPropertyDelta(FPropertyDelta&& Other)
+	: Property(Other.Property)
+	, Values(Other.Values)
+{
+	Other.Property = nullptr;
+	Other.Values = nullptr;
+}
+
+FAtkStructArrayHistory::FPropertyDelta::~FPropertyDelta()
+{
+	if(!Values)
+		return;
+
+	const int32 ValueOffset = Align(Property->GetSize(), Property->GetMinAlignment());
+	Property->DestroyValue(Values);
+	Property->DestroyValue(Values + ValueOffset);
+	FMemory::Free(Values);
+}
+
+void FAtkStructArrayHistory::FPropertyDelta::Apply(void* Container, bool bNewValue) const
+{
+	const int32 ValueOffset = bNewValue ? Align(Property->GetSize(), Property->GetMinAlignment()) : 0;
+	Property->CopyCompleteValue(Property->ContainerPtrToValuePtr<void>(Container), Values + ValueOffset);
+}
+
+SIZE_T FAtkStructArrayHistory::FPropertyDelta::GetAllocatedSize() const
+{
+	return sizeof(FPropertyDelta) + Align(Property->GetSize(), Property->GetMinAlignment()) * 2;
+}
+
+FAtkStructArrayHistory::FAtkStructArrayHistory(SIZE_T InMemoryBudget)
+	: MemoryBudget(InMemoryBudget)
+{
+}
+
+void FAtkStructArrayHistory::SetMemoryBudget(SIZE_T InMemoryBudget)
+{
+	MemoryBudget = InMemoryBudget;
+	EnforceBudget();
+}
+
+void FAtkStructArrayHistory::BeginTransaction()
+{
+	if(TransactionDepth++ == 0)
+	{
+		// the transaction is only stored once something is recorded in it
+		bTransactionOpened = false;
+	}
+}
+
+void FAtkStructArrayHistory::EndTransaction()
+{
+	if(TransactionDepth > 0 && --TransactionDepth == 0)
+	{
+		EnforceBudget();
+	}
+}
+
+FAtkStructArrayHistory::FRecord& FAtkStructArrayHistory::AddRecord(ERecordType Type, SIZE_T RecordSize)
+{
+	if(TransactionDepth == 0 || !bTransactionOpened)
+	{
+		// a new edit drops what could be redone
+		for(int32 i = Cursor; i < Transactions.Num(); ++i)
+		{
+			AllocatedSize -= Transactions[i].AllocatedSize;
+		}
+		Transactions.SetNum(Cursor);
+		Transactions.AddDefaulted();
+		++Cursor;
+		bTransactionOpened = TransactionDepth > 0;
+	}
+
+	FTransaction& Transaction = Transactions.Last();
+	Transaction.AllocatedSize += RecordSize + sizeof(FRecord);
+	AllocatedSize += RecordSize + sizeof(FRecord);
+	FRecord& Record = Transaction.Records.AddDefaulted_GetRef();
+	Record.Type = Type;
+	return Record;
+}
+
+void FAtkStructArrayHistory::RecordInsert(int32 Index, TConstArrayView<FInstancedStruct> Structs)
+{
+	if(Structs.IsEmpty())
+		return;
+
+	FRecord& Record = AddRecord(ERecordType::Insert, GetStructsSize(Structs));
+	Record.Index = Index;
+	Record.Structs.Append(Structs.GetData(), Structs.Num());
+	EnforceBudget();
+}
+
+void FAtkStructArrayHistory::RecordRemove(int32 Index, TConstArrayView<FInstancedStruct> Structs)
+{
+	if(Structs.IsEmpty())
+		return;
+
+	FRecord& Record = AddRecord(ERecordType::Remove, GetStructsSize(Structs));
+	Record.Index = Index;
+	Record.Structs.Append(Structs.GetData(), Structs.Num());
+	EnforceBudget();
+}
+
+void FAtkStructArrayHistory::RecordSwap(int32 FirstIndex, int32 SecondIndex)
+{
+	FRecord& Record = AddRecord(ERecordType::Swap, 0);
+	Record.Index = FirstIndex;
+	Record.OtherIndex = SecondIndex;
+	EnforceBudget();
+}
+
+void FAtkStructArrayHistory::RecordSet(int32 Index, const FInstancedStruct& OldStruct, const FInstancedStruct& NewStruct)
+{
+	const UScriptStruct* StructType = OldStruct.GetScriptStruct();
+	if(!StructType || StructType != NewStruct.GetScriptStruct())
+	{
+		const FInstancedStruct Structs[] = { OldStruct, NewStruct };
+		FRecord& Record = AddRecord(ERecordType::Set, GetStructsSize(Structs));
+		Record.Index = Index;
+		Record.Structs.Append(Structs, UE_ARRAY_COUNT(Structs));
+		EnforceBudget();
+		return;
+	}
+
+	TBitArray<> Changed;
+	if(!UAtkStructUtilsFunctionLibrary::DiffStructs(StructType, OldStruct.GetMemory(), NewStruct.GetMemory(), Changed))
+		return;
+
+	const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = FAtkStructLayout::Get(StructType);
+	const TConstArrayView<FAtkStructLayout::FPropertyLayout> Properties = Layout->GetProperties();
+	TArray<FPropertyDelta> Deltas;
+	SIZE_T DeltasSize = 0;
+	for(TConstSetBitIterator<> It(Changed); It; ++It)
+	{
+		const FPropertyDelta& Delta = Deltas.Emplace_GetRef(Properties[It.GetIndex()].Property, OldStruct.GetMemory(), NewStruct.GetMemory());
+		DeltasSize += Delta.GetAllocatedSize();
+	}
+
+	FRecord& Record = AddRecord(ERecordType::Set, DeltasSize);
+	Record.Index = Index;
+	Record.Deltas = MoveTemp(Deltas);
+	EnforceBudget();
+}
+
+void FAtkStructArrayHistory::RecordSetArray(FArraySnapshot OldStructs, FArraySnapshot NewStructs)
+{
+	FRecord& Record = AddRecord(ERecordType::SetArray, GetStructsSize(*OldStructs) + GetStructsSize(*NewStructs));
+	Record.OldArray = MoveTemp(OldStructs);
+	Record.NewArray = MoveTemp(NewStructs);
+	EnforceBudget();
+}
+
+bool FAtkStructArrayHistory::Undo(IEditTarget& Target)
+{
+	if(!CanUndo())
+		return false;
+
+	const FTransaction& Transaction = Transactions[--Cursor];
+	for(int32 i = Transaction.Records.Num() - 1; i >= 0; --i)
+	{
+		Apply(Transaction.Records[i], Target, true);
+	}
+	return true;
+}
+
+bool FAtkStructArrayHistory::Redo(IEditTarget& Target)
+{
+	if(!CanRedo())
+		return false;
+
+	const FTransaction& Transaction = Transactions[Cursor++];
+	for(const FRecord& Record : Transaction.Records)
+	{
+		Apply(Record, Target, false);
+	}
+	return true;
+}
+
+void FAtkStructArrayHistory::Reset()
+{
+	NumEvicted += Cursor;
+	Transactions.Reset();
+	Cursor = 0;
+	bTransactionOpened = false;
+	AllocatedSize = 0;
+}
+
+void FAtkStructArrayHistory::Apply(const FRecord& Record, IEditTarget& Target, bool bUndo) const
+{
+	switch(Record.Type)
+	{
+	case ERecordType::Insert:
+		if(bUndo)
+			Target.RemoveAt(Record.Index, Record.Structs.Num());
+		else
+			Target.InsertAt(Record.Index, Record.Structs);
+		break;
+	case ERecordType::Remove:
+		if(bUndo)
+			Target.InsertAt(Record.Index, Record.Structs);
+		else
+			Target.RemoveAt(Record.Index, Record.Structs.Num());
+		break;
+	case ERecordType::Swap:
+		Target.Swap(Record.Index, Record.OtherIndex);
+		break;
+	case ERecordType::Set:
+		if(Record.Deltas.IsEmpty())
+		{
+			Target.SetAt(Record.Index, FInstancedStruct(Record.Structs[bUndo ? 0 : 1]));
+		}
+		else if(const FInstancedStruct* Current = Target.GetAt(Record.Index))
+		{
+			FInstancedStruct Edited = *Current;
+			for(const FPropertyDelta& Delta : Record.Deltas)
+			{
+				Delta.Apply(Edited.GetMutableMemory(), !bUndo);
+			}
+			Target.SetAt(Record.Index, MoveTemp(Edited));
+		}
+		break;
+	case ERecordType::SetArray:
+		Target.SetArray(bUndo ? *Record.OldArray : *Record.NewArray);
+		break;
+	}
+}
+
+void FAtkStructArrayHistory::EnforceBudget()
+{
+	// the last applied transaction, which is the open one while recording, is always kept
+	int32 NumToEvict = 0;
+	SIZE_T Size = AllocatedSize;
+	while(Size > MemoryBudget && NumToEvict < Cursor - 1)
+	{
+		Size -= Transactions[NumToEvict++].AllocatedSize;
+	}
+	if(NumToEvict == 0)
+		return;
+
+	Transactions.RemoveAt(0, NumToEvict);
+	AllocatedSize = Size;
+	Cursor -= NumToEvict;
+	NumEvicted += NumToEvict;
+}
+
+SIZE_T FAtkStructArrayHistory::GetStructsSize(TConstArrayView<FInstancedStruct> Structs)
+{
+	SIZE_T Size = Structs.Num() * sizeof(FInstancedStruct);
+	for(const FInstancedStruct& Struct : Structs)
+	{
+		if(const UScriptStruct* StructType = Struct.GetScriptStruct())
+		{
+			Size += StructType->GetStructureSize();
+		}
+	}
+	return Size;
+}
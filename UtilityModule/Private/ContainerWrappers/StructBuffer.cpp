@@ -0,0 +1,240 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "ContainerWrappers/StructBuffer.h"
+#include "UObject/GarbageCollection.h"
+
+FAtkStructBuffer::FAtkStructBuffer(const UScriptStruct* InScriptStruct, int32 InitialCapacity)
+{
+	Initialize(InScriptStruct, InitialCapacity);
+}
+
+FAtkStructBuffer::FAtkStructBuffer(const FAtkStructBuffer& Other)
+{
+	*this = Other;
+}
+
+FAtkStructBuffer::FAtkStructBuffer(FAtkStructBuffer&& Other)
+{
+	*this = MoveTemp(Other);
+}
+
+FAtkStructBuffer& FAtkStructBuffer::operator=(const FAtkStructBuffer& Other)
+{
+	if(this != &Other)
+	{
+		Initialize(Other.ScriptStruct, Other.NumElements);
+		if(Other.NumElements > 0)
+		{
+			Layout->InitializeStruct(Memory, Other.NumElements);
+			Layout->CopyStruct(Memory, Other.Memory, Other.NumElements);
+			NumElements = Other.NumElements;
+		}
+	}
+	return *this;
+}
+
+FAtkStructBuffer& FAtkStructBuffer::operator=(FAtkStructBuffer&& Other)
+{
+	if(this != &Other)
+	{
+		Empty();
+		ScriptStruct = Other.ScriptStruct;
+		Layout = MoveTemp(Other.Layout);
+		Memory = Other.Memory;
+		NumElements = Other.NumElements;
+		Capacity = Other.Capacity;
+		Stride = Other.Stride;
+		
+		Other.ScriptStruct = nullptr;
+		Other.Memory = nullptr;
+		Other.NumElements = 0;
+		Other.Capacity = 0;
+		Other.Stride = 0;
+	}
+	return *this;
+}
+
+FAtkStructBuffer::~FAtkStructBuffer()
+{
+	Empty();
+}
+
+void FAtkStructBuffer::Initialize(const UScriptStruct* InScriptStruct, int32 InitialCapacity)
+{
+	Empty();
+	ScriptStruct = InScriptStruct;
+	Layout = FAtkStructLayout::Get(InScriptStruct);
+	// the structure size is already a multiple of the alignment
+	Stride = Layout ? Layout->GetSize() : 0;
+	if(InitialCapacity > 0)
+	{
+		Reserve(InitialCapacity);
+	}
+}
+
+void FAtkStructBuffer::Reserve(int32 NewCapacity)
+{
+	if(NewCapacity > Capacity)
+	{
+		Grow(NewCapacity);
+	}
+}
+
+void FAtkStructBuffer::Grow(int32 MinCapacity)
+{
+	check(Layout);
+	const int32 NewCapacity = FMath::Max3(MinCapacity, Capacity + Capacity / 2, 4);
+	// structs are relocated with a plain copy of their bytes, the same assumption TArray makes
+	Memory = static_cast<uint8*>(FMemory::Realloc(Memory, static_cast<SIZE_T>(NewCapacity) * Stride, Layout->GetAlignment()));
+	Capacity = NewCapacity;
+}
+
+int32 FAtkStructBuffer::AddDefaulted(int32 Count)
+{
+	if(!Layout || Count <= 0)
+		return INDEX_NONE;
+	
+	const int32 FirstIndex = NumElements;
+	if(NumElements + Count > Capacity)
+	{
+		Grow(NumElements + Count);
+	}
+	Layout->InitializeStruct(GetElementPtr(FirstIndex), Count);
+	NumElements += Count;
+	return FirstIndex;
+}
+
+int32 FAtkStructBuffer::Add(FConstStructView Value)
+{
+	if(!Layout || Value.GetScriptStruct() != ScriptStruct)
+		return INDEX_NONE;
+	
+	// Value can be an element of this buffer, growing would free its memory before it is copied
+	const uint8* Source = Value.GetMemory();
+	const bool bAliased = Source >= Memory && Source < Memory + static_cast<SIZE_T>(Capacity) * Stride;
+	const SIZE_T AliasedOffset = bAliased ? Source - Memory : 0;
+	
+	const int32 Index = AddDefaulted();
+	Layout->CopyStruct(GetElementPtr(Index), bAliased ? Memory + AliasedOffset : Source);
+	return Index;
+}
+
+int32 FAtkStructBuffer::Add(const FInstancedStruct& Value)
+{
+	return Add(FConstStructView(Value.GetScriptStruct(), Value.GetMemory()));
+}
+
+bool FAtkStructBuffer::SetAt(int32 Index, FConstStructView Value)
+{
+	if(!IsValidIndex(Index) || Value.GetScriptStruct() != ScriptStruct)
+		return false;
+	
+	Layout->CopyStruct(GetElementPtr(Index), Value.GetMemory());
+	return true;
+}
+
+int32 FAtkStructBuffer::Append(TConstArrayView<FInstancedStruct> Values)
+{
+	if(!Layout)
+		return 0;
+	
+	Reserve(NumElements + Values.Num());
+	int32 Added = 0;
+	for(const FInstancedStruct& Value : Values)
+	{
+		if(Add(Value) != INDEX_NONE)
+		{
+			Added++;
+		}
+	}
+	return Added;
+}
+
+void FAtkStructBuffer::RemoveAt(int32 Index)
+{
+	check(IsValidIndex(Index));
+	Layout->DestroyStruct(GetElementPtr(Index));
+	const int32 NumToMove = NumElements - Index - 1;
+	if(NumToMove > 0)
+	{
+		FMemory::Memmove(GetElementPtr(Index), GetElementPtr(Index + 1), static_cast<SIZE_T>(NumToMove) * Stride);
+	}
+	NumElements--;
+}
+
+void FAtkStructBuffer::RemoveAtSwap(int32 Index)
+{
+	check(IsValidIndex(Index));
+	Layout->DestroyStruct(GetElementPtr(Index));
+	const int32 LastIndex = NumElements - 1;
+	if(Index != LastIndex)
+	{
+		FMemory::Memcpy(GetElementPtr(Index), GetElementPtr(LastIndex), Stride);
+	}
+	NumElements--;
+}
+
+void FAtkStructBuffer::Reset()
+{
+	if(Layout && NumElements > 0)
+	{
+		Layout->DestroyStruct(Memory, NumElements);
+	}
+	NumElements = 0;
+}
+
+void FAtkStructBuffer::Empty()
+{
+	Reset();
+	if(Memory)
+	{
+		FMemory::Free(Memory);
+		Memory = nullptr;
+	}
+	Capacity = 0;
+}
+
+FStructView FAtkStructBuffer::GetAt(int32 Index)
+{
+	check(IsValidIndex(Index));
+	return FStructView(ScriptStruct, GetElementPtr(Index));
+}
+
+FConstStructView FAtkStructBuffer::GetAt(int32 Index) const
+{
+	check(IsValidIndex(Index));
+	return FConstStructView(ScriptStruct, GetElementPtr(Index));
+}
+
+FInstancedStruct FAtkStructBuffer::GetInstancedStruct(int32 Index) const
+{
+	FInstancedStruct Instance;
+	if(IsValidIndex(Index))
+	{
+		Instance.InitializeAs(ScriptStruct, GetElementPtr(Index));
+	}
+	return Instance;
+}
+
+TArray<FInstancedStruct> FAtkStructBuffer::ToArray() const
+{
+	TArray<FInstancedStruct> Array;
+	Array.SetNum(NumElements);
+	for(int32 Index = 0; Index < NumElements; ++Index)
+	{
+		Array[Index].InitializeAs(ScriptStruct, GetElementPtr(Index));
+	}
+	return Array;
+}
+
+void FAtkStructBuffer::AddStructReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(ScriptStruct);
+	// only walk the elements when the struct can hold references
+	if(ScriptStruct && (ScriptStruct->RefLink || (ScriptStruct->StructFlags & STRUCT_AddStructReferencedObjects)))
+	{
+		for(int32 Index = 0; Index < NumElements; ++Index)
+		{
+			Collector.AddPropertyReferencesWithStructARO(ScriptStruct, GetElementPtr(Index));
+		}
+	}
+}
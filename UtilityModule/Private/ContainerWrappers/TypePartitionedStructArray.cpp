@@ -0,0 +1,243 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "ContainerWrappers/TypePartitionedStructArray.h"
+
+int32 FAtkTypePartitionedStructArray::Add(FConstStructView Value)
+{
+	if(!Value.IsValid())
+		return INDEX_NONE;
+
+	const int32 Bucket = FindOrAddBucket(Value.GetScriptStruct());
+	return AddToOrder(Bucket, Buckets[Bucket].Add(Value));
+}
+
+int32 FAtkTypePartitionedStructArray::Add(const FInstancedStruct& Value)
+{
+	return Add(FConstStructView(Value.GetScriptStruct(), Value.GetMemory()));
+}
+
+int32 FAtkTypePartitionedStructArray::AddDefaulted(const UScriptStruct* StructType)
+{
+	if(!StructType)
+		return INDEX_NONE;
+
+	const int32 Bucket = FindOrAddBucket(StructType);
+	return AddToOrder(Bucket, Buckets[Bucket].AddDefaulted());
+}
+
+void FAtkTypePartitionedStructArray::Append(TConstArrayView<FInstancedStruct> Values)
+{
+	Order.Reserve(Order.Num() + Values.Num());
+	OrderSlots.Reserve(OrderSlots.Num() + Values.Num());
+	for(const FInstancedStruct& Value : Values)
+	{
+		Add(Value);
+	}
+}
+
+void FAtkTypePartitionedStructArray::RemoveAt(int32 GlobalIndex)
+{
+	if(!Order.IsValidIndex(GlobalIndex))
+		return;
+
+	RemoveFromBucket(Order[GlobalIndex]);
+	ReleaseSlot(OrderSlots[GlobalIndex]);
+	Order.RemoveAt(GlobalIndex);
+	OrderSlots.RemoveAt(GlobalIndex);
+	for(int32 i = GlobalIndex; i < Order.Num(); ++i)
+	{
+		SetGlobalIndex(i);
+	}
+}
+
+void FAtkTypePartitionedStructArray::RemoveAtSwap(int32 GlobalIndex)
+{
+	if(!Order.IsValidIndex(GlobalIndex))
+		return;
+
+	RemoveFromBucket(Order[GlobalIndex]);
+	ReleaseSlot(OrderSlots[GlobalIndex]);
+	Order.RemoveAtSwap(GlobalIndex);
+	OrderSlots.RemoveAtSwap(GlobalIndex);
+	if(Order.IsValidIndex(GlobalIndex))
+	{
+		SetGlobalIndex(GlobalIndex);
+	}
+}
+
+void FAtkTypePartitionedStructArray::Reset()
+{
+	for(FAtkStructBuffer& Bucket : Buckets)
+	{
+		Bucket.Reset();
+	}
+	for(TArray<int32>& GlobalIndices : BucketGlobalIndices)
+	{
+		GlobalIndices.Reset();
+	}
+	ReleaseAllSlots();
+	Order.Reset();
+	OrderSlots.Reset();
+}
+
+void FAtkTypePartitionedStructArray::Empty()
+{
+	Buckets.Empty();
+	BucketGlobalIndices.Empty();
+	ReleaseAllSlots();
+	Order.Empty();
+	OrderSlots.Empty();
+	BucketMap.Empty();
+}
+
+TArray<const UScriptStruct*> FAtkTypePartitionedStructArray::GetTypes() const
+{
+	TArray<const UScriptStruct*> Types;
+	BucketMap.GenerateKeyArray(Types);
+	return Types;
+}
+
+FStructView FAtkTypePartitionedStructArray::GetAt(int32 GlobalIndex)
+{
+	check(Order.IsValidIndex(GlobalIndex));
+	const FAtkPartitionedIndex& Location = Order[GlobalIndex];
+	return Buckets[Location.Bucket].GetAt(Location.Index);
+}
+
+FConstStructView FAtkTypePartitionedStructArray::GetAt(int32 GlobalIndex) const
+{
+	check(Order.IsValidIndex(GlobalIndex));
+	const FAtkPartitionedIndex& Location = Order[GlobalIndex];
+	return Buckets[Location.Bucket].GetAt(Location.Index);
+}
+
+int32 FAtkTypePartitionedStructArray::GetGlobalIndex(const FAtkPartitionedIndex& PartitionedIndex) const
+{
+	if(!BucketGlobalIndices.IsValidIndex(PartitionedIndex.Bucket)
+		|| !BucketGlobalIndices[PartitionedIndex.Bucket].IsValidIndex(PartitionedIndex.Index))
+		return INDEX_NONE;
+	
+	return BucketGlobalIndices[PartitionedIndex.Bucket][PartitionedIndex.Index];
+}
+
+FAtkPartitionedHandle FAtkTypePartitionedStructArray::GetHandle(int32 GlobalIndex) const
+{
+	if(!OrderSlots.IsValidIndex(GlobalIndex))
+		return FAtkPartitionedHandle();
+
+	const int32 Slot = OrderSlots[GlobalIndex];
+	return FAtkPartitionedHandle(Slot, SlotGenerations[Slot]);
+}
+
+int32 FAtkTypePartitionedStructArray::GetGlobalIndex(const FAtkPartitionedHandle& Handle) const
+{
+	if(!SlotGenerations.IsValidIndex(Handle.Slot) || SlotGenerations[Handle.Slot] != Handle.Generation)
+		return INDEX_NONE;
+
+	return SlotGlobalIndices[Handle.Slot];
+}
+
+FStructView FAtkTypePartitionedStructArray::Find(const FAtkPartitionedHandle& Handle)
+{
+	const int32 GlobalIndex = GetGlobalIndex(Handle);
+	return GlobalIndex != INDEX_NONE ? GetAt(GlobalIndex) : FStructView();
+}
+
+FConstStructView FAtkTypePartitionedStructArray::Find(const FAtkPartitionedHandle& Handle) const
+{
+	const int32 GlobalIndex = GetGlobalIndex(Handle);
+	return GlobalIndex != INDEX_NONE ? GetAt(GlobalIndex) : FConstStructView();
+}
+
+void FAtkTypePartitionedStructArray::Remove(const FAtkPartitionedHandle& Handle)
+{
+	RemoveAt(GetGlobalIndex(Handle));
+}
+
+FAtkStructBuffer* FAtkTypePartitionedStructArray::FindBucket(const UScriptStruct* StructType)
+{
+	const int32* Bucket = BucketMap.Find(StructType);
+	return Bucket ? &Buckets[*Bucket] : nullptr;
+}
+
+const FAtkStructBuffer* FAtkTypePartitionedStructArray::FindBucket(const UScriptStruct* StructType) const
+{
+	const int32* Bucket = BucketMap.Find(StructType);
+	return Bucket ? &Buckets[*Bucket] : nullptr;
+}
+
+TArray<FInstancedStruct> FAtkTypePartitionedStructArray::ToArray() const
+{
+	TArray<FInstancedStruct> Array;
+	Array.Reserve(Order.Num());
+	ForEachInOrder([&Array](FConstStructView View)
+	{
+		Array.Emplace_GetRef().InitializeAs(View.GetScriptStruct(), View.GetMemory());
+	});
+	return Array;
+}
+
+int32 FAtkTypePartitionedStructArray::FindOrAddBucket(const UScriptStruct* StructType)
+{
+	if(const int32* Bucket = BucketMap.Find(StructType))
+		return *Bucket;
+
+	const int32 Bucket = Buckets.Emplace(StructType);
+	BucketGlobalIndices.AddDefaulted();
+	BucketMap.Add(StructType, Bucket);
+	return Bucket;
+}
+
+int32 FAtkTypePartitionedStructArray::AddToOrder(int32 Bucket, int32 LocalIndex)
+{
+	const int32 GlobalIndex = Order.Emplace(Bucket, LocalIndex);
+	BucketGlobalIndices[Bucket].Add(GlobalIndex);
+
+	int32 Slot;
+	if(FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+		SlotGlobalIndices[Slot] = GlobalIndex;
+	}
+	else
+	{
+		Slot = SlotGlobalIndices.Add(GlobalIndex);
+		SlotGenerations.Add(1);
+	}
+	OrderSlots.Add(Slot);
+	return GlobalIndex;
+}
+
+void FAtkTypePartitionedStructArray::SetGlobalIndex(int32 GlobalIndex)
+{
+	const FAtkPartitionedIndex& Location = Order[GlobalIndex];
+	BucketGlobalIndices[Location.Bucket][Location.Index] = GlobalIndex;
+	SlotGlobalIndices[OrderSlots[GlobalIndex]] = GlobalIndex;
+}
+
+void FAtkTypePartitionedStructArray::ReleaseSlot(int32 Slot)
+{
+	SlotGlobalIndices[Slot] = INDEX_NONE;
+	++SlotGenerations[Slot];
+	FreeSlots.Add(Slot);
+}
+
+void FAtkTypePartitionedStructArray::ReleaseAllSlots()
+{
+	for(const int32 Slot : OrderSlots)
+	{
+		ReleaseSlot(Slot);
+	}
+}
+
+void FAtkTypePartitionedStructArray::RemoveFromBucket(const FAtkPartitionedIndex& Location)
+{
+	FAtkStructBuffer& Bucket = Buckets[Location.Bucket];
+	TArray<int32>& GlobalIndices = BucketGlobalIndices[Location.Bucket];
+	
+	Bucket.RemoveAtSwap(Location.Index);
+	GlobalIndices.RemoveAtSwap(Location.Index);
+	if(GlobalIndices.IsValidIndex(Location.Index))
+	{
+		Order[GlobalIndices[Location.Index]].Index = Location.Index;
+	}
+}
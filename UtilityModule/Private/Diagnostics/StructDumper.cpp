@@ -0,0 +1,413 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "Diagnostics/StructDumper.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/StringBuilder.h"
+#include "Reflection/StructLayout.h"
+#include "UtilityModule.h"
+
+namespace AtkStructDump
+{
+	// Text is handed to the log or the file once a chunk grows past this many characters
+	static constexpr int32 LogChunkSize = 16 * 1024;
+	static constexpr int32 FileChunkSize = 1024 * 1024;
+
+	static bool PassesFilter(const FProperty* Property, TConstArrayView<FString> PropertyFilter)
+	{
+		if(PropertyFilter.IsEmpty())
+			return true;
+
+		const FString AuthoredName = Property->GetAuthoredName();
+		return PropertyFilter.ContainsByPredicate([&AuthoredName, Property](const FString& Name)
+		{
+			return Name == AuthoredName || Property->GetFName() == FName(*Name, FNAME_Find);
+		});
+	}
+
+	// Exported text of the properties that reference objects, keyed by row and property.
+	// Objects are only safe to read on the game thread, the async dumps export them before handing the rows to a worker
+	using FObjectValues = TMap<TPair<int32, const FProperty*>, FString>;
+
+	static bool ReferencesObjects(const FProperty* Property)
+	{
+		TArray<const FStructProperty*> EncounteredStructs;
+		return Property->ContainsObjectReference(EncounteredStructs, EPropertyObjectReferenceType::Strong | EPropertyObjectReferenceType::Weak);
+	}
+
+	// Properties dumped for a struct type, resolved once per type and dump
+	struct FColumns
+	{
+		TMap<const UScriptStruct*, TArray<const FProperty*>> ByType;
+		TConstArrayView<FString> PropertyFilter;
+
+		const TArray<const FProperty*>& Get(const UScriptStruct* Struct)
+		{
+			if(const TArray<const FProperty*>* Found = ByType.Find(Struct))
+				return *Found;
+
+			TArray<const FProperty*>& Columns = ByType.Add(Struct);
+			if(const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = FAtkStructLayout::Get(Struct))
+			{
+				for(const FProperty* Property : Layout->GetOrderedProperties())
+				{
+					if(PassesFilter(Property, PropertyFilter))
+					{
+						Columns.Add(Property);
+					}
+				}
+			}
+			return Columns;
+		}
+	};
+
+	static void ExportValue(FString& OutValue, const FProperty* Property, const void* StructMemory)
+	{
+		OutValue.Reset();
+		Property->ExportTextItem_Direct(OutValue, Property->ContainerPtrToValuePtr<void>(StructMemory), nullptr, nullptr, PPF_None);
+	}
+
+	// Uses the text exported beforehand for the properties that reference objects
+	static void ExportValue(FString& OutValue, const FProperty* Property, const void* StructMemory, int32 Row, const FObjectValues* ObjectValues)
+	{
+		if(ObjectValues)
+		{
+			if(const FString* Exported = ObjectValues->Find(MakeTuple(Row, Property)))
+			{
+				OutValue = *Exported;
+				return;
+			}
+		}
+		ExportValue(OutValue, Property, StructMemory);
+	}
+
+	// Rows are positions in Indices, as in WriteRows
+	static FObjectValues ExportObjectValues(TConstArrayView<FInstancedStruct> Structs, TConstArrayView<int32> Indices,
+		const FAtkStructDumpOptions& Options)
+	{
+		FColumns Columns;
+		Columns.PropertyFilter = Options.PropertyFilter;
+		TMap<const UScriptStruct*, TArray<const FProperty*>> ObjectColumns;
+		FObjectValues ObjectValues;
+		for(int32 Row = 0; Row < Indices.Num(); ++Row)
+		{
+			const FInstancedStruct& Struct = Structs[Indices[Row]];
+			const UScriptStruct* Type = Struct.GetScriptStruct();
+			if(!Type)
+				continue;
+
+			TArray<const FProperty*>* TypeObjectColumns = ObjectColumns.Find(Type);
+			if(!TypeObjectColumns)
+			{
+				TypeObjectColumns = &ObjectColumns.Add(Type, Columns.Get(Type).FilterByPredicate(&ReferencesObjects));
+			}
+			for(const FProperty* Property : *TypeObjectColumns)
+			{
+				ExportValue(ObjectValues.Add(MakeTuple(Row, Property)), Property, Struct.GetMemory());
+			}
+		}
+		return ObjectValues;
+	}
+
+	static void AppendCsvField(FStringBuilderBase& Builder, const FString& Value)
+	{
+		int32 Index = INDEX_NONE;
+		const bool bNeedsQuotes = Value.FindChar(TEXT(','), Index) || Value.FindChar(TEXT('"'), Index)
+			|| Value.FindChar(TEXT('\n'), Index) || Value.FindChar(TEXT('\r'), Index);
+		if(!bNeedsQuotes)
+		{
+			Builder << Value;
+			return;
+		}
+		Builder << TEXT('"') << Value.Replace(TEXT("\""), TEXT("\"\"")) << TEXT('"');
+	}
+
+	static void AppendJsonString(FStringBuilderBase& Builder, FStringView Value)
+	{
+		Builder << TEXT('"');
+		for(const TCHAR Char : Value)
+		{
+			switch(Char)
+			{
+			case TEXT('"'): Builder << TEXT("\\\""); break;
+			case TEXT('\\'): Builder << TEXT("\\\\"); break;
+			case TEXT('\n'): Builder << TEXT("\\n"); break;
+			case TEXT('\r'): Builder << TEXT("\\r"); break;
+			case TEXT('\t'): Builder << TEXT("\\t"); break;
+			default:
+				if(Char < 0x20)
+				{
+					Builder.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+				}
+				else
+				{
+					Builder.AppendChar(Char);
+				}
+			}
+		}
+		Builder << TEXT('"');
+	}
+
+	// Numbers and bools are written as json values, everything else as strings
+	static bool IsRawJsonValue(const FProperty* Property)
+	{
+		if(const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+			return !NumericProperty->IsEnum();
+		return Property->IsA<FBoolProperty>();
+	}
+
+	// Json has no literal for infinity or NaN
+	static bool IsNonFiniteValue(const FProperty* Property, const void* StructMemory)
+	{
+		const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+		return NumericProperty && NumericProperty->IsFloatingPoint()
+			&& !FMath::IsFinite(NumericProperty->GetFloatingPointPropertyValue(Property->ContainerPtrToValuePtr<void>(StructMemory)));
+	}
+
+	/** Sends chunks of text either to the log or to a file */
+	class FChunkWriter
+	{
+	public:
+		explicit FChunkWriter(const FAtkStructDumpOptions& Options)
+			: bToLog(Options.Format == EAtkStructDumpFormat::Log)
+		{
+			if(!bToLog)
+			{
+				Path = FAtkStructDumper::GetOutputPath(Options);
+				File.Reset(IFileManager::Get().CreateFileWriter(*Path));
+				if(!File)
+				{
+					UE_LOG(LogUtilityModule, Error, TEXT("Struct dump: failed to open file for writing: %s"), *Path);
+				}
+			}
+		}
+
+		bool IsValid() const { return bToLog || File.IsValid(); }
+		int32 GetChunkSize() const { return bToLog ? LogChunkSize : FileChunkSize; }
+
+		void Flush(FStringBuilderBase& Builder)
+		{
+			if(Builder.Len() == 0)
+				return;
+			
+			if(bToLog)
+			{
+				UE_LOG(LogUtilityModule, Display, TEXT("%s"), Builder.ToString());
+			}
+			else if(File)
+			{
+				const FTCHARToUTF8 Utf8(Builder.ToString(), Builder.Len());
+				File->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+			}
+			Builder.Reset();
+		}
+
+		bool Close()
+		{
+			if(!File)
+				return bToLog;
+			
+			const bool bResult = File->Close() && !File->IsError();
+			UE_LOG(LogUtilityModule, Display, TEXT("Struct dump written to %s"), *Path);
+			return bResult;
+		}
+
+	private:
+		bool bToLog = true;
+		FString Path;
+		TUniquePtr<FArchive> File;
+	};
+
+	static void AppendLogRow(FStringBuilderBase& Builder, FConstStructView Struct, const TArray<const FProperty*>& Columns, FString& Value,
+		int32 Row = INDEX_NONE, const FObjectValues* ObjectValues = nullptr)
+	{
+		Builder << Struct.GetScriptStruct()->GetName() << TEXT(" {");
+		for(int32 Column = 0; Column < Columns.Num(); ++Column)
+		{
+			ExportValue(Value, Columns[Column], Struct.GetMemory(), Row, ObjectValues);
+			Builder << (Column == 0 ? TEXT(" ") : TEXT(", ")) << Columns[Column]->GetAuthoredName() << TEXT(": ") << Value;
+		}
+		Builder << TEXT(" }");
+	}
+
+	// RowNumbers are the indices printed for each row, the indices in Structs are used when empty.
+	// ObjectValues must hold the properties that reference objects when called outside of the game thread
+	static bool WriteRows(TConstArrayView<FInstancedStruct> Structs, TConstArrayView<int32> Indices, TConstArrayView<int32> RowNumbers,
+		const FAtkStructDumpOptions& Options, const FObjectValues* ObjectValues = nullptr)
+	{
+		FChunkWriter Writer(Options);
+		if(!Writer.IsValid())
+			return false;
+
+		FColumns Columns;
+		Columns.PropertyFilter = Options.PropertyFilter;
+		TStringBuilder<4096> Builder;
+		FString Value;
+		const UScriptStruct* CsvType = nullptr;
+		bool bFirstJsonRow = true;
+
+		if(Options.Format == EAtkStructDumpFormat::Json)
+		{
+			Builder << TEXT("[");
+		}
+		for(int32 Row = 0; Row < Indices.Num(); ++Row)
+		{
+			const FInstancedStruct& Struct = Structs[Indices[Row]];
+			const int32 Index = RowNumbers.IsEmpty() ? Indices[Row] : RowNumbers[Row];
+			const UScriptStruct* Type = Struct.GetScriptStruct();
+			if(!Type)
+				continue;
+
+			const TArray<const FProperty*>& TypeColumns = Columns.Get(Type);
+			switch(Options.Format)
+			{
+			case EAtkStructDumpFormat::Log:
+				Builder << TEXT("\n[") << Index << TEXT("] ");
+				AppendLogRow(Builder, FConstStructView(Type, Struct.GetMemory()), TypeColumns, Value, Row, ObjectValues);
+				break;
+				
+			case EAtkStructDumpFormat::Csv:
+				// a new header every time the struct type changes
+				if(Type != CsvType)
+				{
+					CsvType = Type;
+					Builder << (Builder.Len() > 0 ? TEXT("\n") : TEXT("")) << TEXT("#") << Type->GetName() << TEXT("\nIndex");
+					for(const FProperty* Property : TypeColumns)
+					{
+						Builder << TEXT(',');
+						AppendCsvField(Builder, Property->GetAuthoredName());
+					}
+					Builder << TEXT('\n');
+				}
+				Builder << Index;
+				for(const FProperty* Property : TypeColumns)
+				{
+					ExportValue(Value, Property, Struct.GetMemory(), Row, ObjectValues);
+					Builder << TEXT(',');
+					AppendCsvField(Builder, Value);
+				}
+				Builder << TEXT('\n');
+				break;
+				
+			case EAtkStructDumpFormat::Json:
+				Builder << (bFirstJsonRow ? TEXT("\n{\"_type\":") : TEXT(",\n{\"_type\":"));
+				bFirstJsonRow = false;
+				AppendJsonString(Builder, Type->GetName());
+				for(const FProperty* Property : TypeColumns)
+				{
+					Builder << TEXT(',');
+					AppendJsonString(Builder, Property->GetAuthoredName());
+					Builder << TEXT(':');
+					if(IsNonFiniteValue(Property, Struct.GetMemory()))
+					{
+						Builder << TEXT("null");
+						continue;
+					}
+					ExportValue(Value, Property, Struct.GetMemory(), Row, ObjectValues);
+					if(IsRawJsonValue(Property))
+					{
+						Builder << Value.ToLower();
+					}
+					else
+					{
+						AppendJsonString(Builder, Value);
+					}
+				}
+				Builder << TEXT('}');
+				break;
+			}
+
+			if(Builder.Len() >= Writer.GetChunkSize())
+			{
+				Writer.Flush(Builder);
+			}
+		}
+		if(Options.Format == EAtkStructDumpFormat::Json)
+		{
+			Builder << TEXT("\n]\n");
+		}
+		Writer.Flush(Builder);
+		return Writer.Close();
+	}
+}
+
+TFuture<bool> FAtkStructDumper::DumpAsync(TConstArrayView<FInstancedStruct> Structs, const FAtkStructDumpOptions& Options)
+{
+	TArray<int32> RowNumbers = GetSampledIndices(Structs.Num(), Options);
+	TArray<FInstancedStruct> Sampled;
+	Sampled.Reserve(RowNumbers.Num());
+	for(const int32 Index : RowNumbers)
+	{
+		Sampled.Add(Structs[Index]);
+	}
+
+	TArray<int32> Indices;
+	Indices.Reserve(Sampled.Num());
+	for(int32 Index = 0; Index < Sampled.Num(); ++Index)
+	{
+		Indices.Add(Index);
+	}
+
+	AtkStructDump::FObjectValues ObjectValues = AtkStructDump::ExportObjectValues(Sampled, Indices, Options);
+	return Async(EAsyncExecution::ThreadPool, [Sampled = MoveTemp(Sampled), Indices = MoveTemp(Indices), RowNumbers = MoveTemp(RowNumbers),
+		ObjectValues = MoveTemp(ObjectValues), Options]()
+	{
+		return AtkStructDump::WriteRows(Sampled, Indices, RowNumbers, Options, &ObjectValues);
+	});
+}
+
+TFuture<bool> FAtkStructDumper::DumpAsync(TArray<FInstancedStruct>&& Structs, const FAtkStructDumpOptions& Options)
+{
+	TArray<int32> Indices = GetSampledIndices(Structs.Num(), Options);
+	AtkStructDump::FObjectValues ObjectValues = AtkStructDump::ExportObjectValues(Structs, Indices, Options);
+	return Async(EAsyncExecution::ThreadPool, [Structs = MoveTemp(Structs), Indices = MoveTemp(Indices), ObjectValues = MoveTemp(ObjectValues), Options]()
+	{
+		return AtkStructDump::WriteRows(Structs, Indices, {}, Options, &ObjectValues);
+	});
+}
+
+bool FAtkStructDumper::Dump(TConstArrayView<FInstancedStruct> Structs, const FAtkStructDumpOptions& Options)
+{
+	return AtkStructDump::WriteRows(Structs, GetSampledIndices(Structs.Num(), Options), {}, Options);
+}
+
+FString FAtkStructDumper::FormatStruct(FConstStructView Struct, TConstArrayView<FString> PropertyFilter)
+{
+	if(!Struct.IsValid())
+		return FString();
+
+	AtkStructDump::FColumns Columns;
+	Columns.PropertyFilter = PropertyFilter;
+	TStringBuilder<512> Builder;
+	FString Value;
+	AtkStructDump::AppendLogRow(Builder, Struct, Columns.Get(Struct.GetScriptStruct()), Value);
+	return FString(Builder.ToView());
+}
+
+TArray<int32> FAtkStructDumper::GetSampledIndices(int32 Num, const FAtkStructDumpOptions& Options)
+{
+	const int32 SampleRate = FMath::Max(Options.SampleRate, 1);
+	int32 NumRows = FMath::DivideAndRoundUp(Num, SampleRate);
+	if(Options.MaxRows > 0)
+	{
+		NumRows = FMath::Min(NumRows, Options.MaxRows);
+	}
+
+	TArray<int32> Indices;
+	Indices.Reserve(NumRows);
+	for(int32 Row = 0; Row < NumRows; ++Row)
+	{
+		Indices.Add(Row * SampleRate);
+	}
+	return Indices;
+}
+
+FString FAtkStructDumper::GetOutputPath(const FAtkStructDumpOptions& Options)
+{
+	if(!Options.FilePath.IsEmpty())
+		return Options.FilePath;
+
+	const TCHAR* Extension = Options.Format == EAtkStructDumpFormat::Json ? TEXT("json") : TEXT("csv");
+	return FPaths::Combine(FPaths::ProjectLogDir(), FString::Printf(TEXT("StructDump_%s.%s"), *FDateTime::Now().ToString(), Extension));
+}
@@ -0,0 +1,93 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "Reflection/ObjectPropertyAccessor.h"
+#include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
+
+FAtkObjectPropertyAccessor::FAtkObjectPropertyAccessor(const UStruct* InOwner, FName InPropertyName, const UClass* InExpectedClass)
+	: Owner(InOwner)
+	, ExpectedClass(InExpectedClass)
+	, OwnerPath(InOwner ? InOwner->GetPathName() : FString())
+	, ExpectedClassPath(InExpectedClass ? InExpectedClass->GetPathName() : FString())
+	, PropertyName(InPropertyName)
+{
+	Resolve();
+}
+
+bool FAtkObjectPropertyAccessor::IsValid() const
+{
+	EnsureResolved();
+	return bCompatible;
+}
+
+const FObjectPropertyBase* FAtkObjectPropertyAccessor::GetProperty() const
+{
+	EnsureResolved();
+	return Property;
+}
+
+UObject* FAtkObjectPropertyAccessor::Read(const void* Container) const
+{
+	EnsureResolved();
+	return bCompatible && Container ? ReadUnchecked(Container) : nullptr;
+}
+
+UObject* FAtkObjectPropertyAccessor::Read(const UObject* Object) const
+{
+	UObject* Value = nullptr;
+	ForEachValue(1, [Object](int32) { return Object; }, [&Value](UObject* InValue) { Value = InValue; });
+	return Value;
+}
+
+void FAtkObjectPropertyAccessor::ReadBatch(TConstArrayView<const UObject*> Objects, TArray<UObject*>& OutValues) const
+{
+	ReadBatch<UObject>(Objects, OutValues);
+}
+
+bool FAtkObjectPropertyAccessor::IsStale() const
+{
+	// reinstancing marks the old class and leaves it alive until the next garbage collection
+	const UStruct* OwnerStruct = Owner.Get();
+	if(!OwnerStruct)
+		return Property != nullptr;
+	if(OwnerStruct->PropertyLink != OwnerPropertyLink || OwnerStruct->GetStructureSize() != OwnerSize)
+		return true;
+	
+	const UClass* OwnerClass = Cast<UClass>(OwnerStruct);
+	const UClass* Expected = ExpectedClass.Get();
+	if(!Expected)
+		return bCompatible;
+	return (OwnerClass && OwnerClass->HasAnyClassFlags(CLASS_NewerVersionExists))
+		|| Expected->HasAnyClassFlags(CLASS_NewerVersionExists);
+}
+
+void FAtkObjectPropertyAccessor::Resolve() const
+{
+	// the old types keep their object but lose their path, the path now leads to the new types
+	if(bResolved)
+	{
+		Owner = FindObject<UStruct>(nullptr, *OwnerPath);
+		ExpectedClass = FindObject<UClass>(nullptr, *ExpectedClassPath);
+	}
+	bResolved = true;
+	Property = nullptr;
+	Offset = INDEX_NONE;
+	bCompatible = false;
+	OwnerPropertyLink = nullptr;
+	OwnerSize = 0;
+
+	const UStruct* OwnerStruct = Owner.Get();
+	if(!OwnerStruct)
+		return;
+	
+	OwnerPropertyLink = OwnerStruct->PropertyLink;
+	OwnerSize = OwnerStruct->GetStructureSize();
+	const UClass* Expected = ExpectedClass.Get();
+	if(!Expected)
+		return;
+
+	Property = CastField<FObjectPropertyBase>(UAtkStructUtilsFunctionLibrary::FindPropertyByName(OwnerStruct, PropertyName));
+	if(!Property)
+		return;
+	
+	Offset = Property->GetOffset_ForInternal();
+	bCompatible = Property->PropertyClass && Property->PropertyClass->IsChildOf(Expected);
+}
@@ -0,0 +1,243 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "Reflection/StructLayout.h"
+#include "Algo/AllOf.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/EnumProperty.h"
+
+namespace AtkStructLayout
+{
+	static TMap<const UScriptStruct*, TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe>> Cache;
+	static FRWLock CacheLock;
+
+	// Groups consecutive properties that pass Predicate and touch each other in memory into runs
+	template <typename PredicateType>
+	static void BuildRuns(TArray<FAtkStructLayout::FPropertyLayout>& Properties, TArray<FAtkStructLayout::FMemoryRun>& OutRuns,
+		int32 FAtkStructLayout::FPropertyLayout::* RunMember, PredicateType Predicate)
+	{
+		FAtkStructLayout::FMemoryRun* Current = nullptr;
+		for(int32 Index = 0; Index < Properties.Num(); ++Index)
+		{
+			FAtkStructLayout::FPropertyLayout& Layout = Properties[Index];
+			if(!Predicate(Layout.Property))
+			{
+				Current = nullptr;
+				continue;
+			}
+			
+			if(!Current || Current->Offset + Current->Size != Layout.Offset)
+			{
+				Current = &OutRuns.AddDefaulted_GetRef();
+				Current->Offset = Layout.Offset;
+				Current->FirstProperty = Index;
+			}
+			Current->Size = Layout.Offset + Layout.Size - Current->Offset;
+			Current->NumProperties++;
+			Layout.*RunMember = OutRuns.Num() - 1;
+		}
+	}
+}
+
+bool FAtkStructLayout::IsMemoryCopyable(const FProperty* Property)
+{
+	if(!Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+		return false;
+		
+	// bitfield bools share their byte with other properties
+	if(const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		return BoolProperty->IsNativeBool();
+	return true;
+}
+
+bool FAtkStructLayout::IsMemoryComparable(const FProperty* Property)
+{
+	if(!IsMemoryCopyable(Property))
+		return false;
+
+	// -0.0 equals 0.0 and NaN never equals itself, floating point values are compared by value
+	if(const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		return !NumericProperty->IsFloatingPoint();
+
+	// nested structs only when their bytes have no padding
+	if(const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = Get(StructProperty->Struct);
+		return Layout && Layout->bFullyComparable && Layout->ComparableRuns.Num() == 1 && Layout->ComparableRuns[0].Size == Layout->Size;
+	}
+	return true;
+}
+
+bool FAtkStructLayout::IsMemorySerializable(const FProperty* Property)
+{
+	if(Property->IsA<FNumericProperty>() || Property->IsA<FEnumProperty>())
+		return true;
+
+	const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property);
+	return BoolProperty && BoolProperty->IsNativeBool();
+}
+
+bool FAtkStructLayout::IsMemoryHashable(const FProperty* Property)
+{
+	if(!IsMemorySerializable(Property))
+		return false;
+	
+	// -0.0 equals 0.0 but has other bytes, floating point values are hashed by value
+	const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+	return !NumericProperty || !NumericProperty->IsFloatingPoint();
+}
+
+TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> FAtkStructLayout::Get(const UScriptStruct* Struct)
+{
+	if(!Struct)
+		return nullptr;
+	
+	{
+		FReadScopeLock ReadLock(AtkStructLayout::CacheLock);
+		const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe>* Found = AtkStructLayout::Cache.Find(Struct);
+		if(Found && (*Found)->IsUpToDate())
+		{
+			return *Found;
+		}
+	}
+
+	TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = MakeShared<const FAtkStructLayout, ESPMode::ThreadSafe>(Struct);
+	FWriteScopeLock WriteLock(AtkStructLayout::CacheLock);
+	AtkStructLayout::Cache.Add(Struct, Layout);
+	return Layout;
+}
+
+void FAtkStructLayout::ClearCache()
+{
+	FWriteScopeLock WriteLock(AtkStructLayout::CacheLock);
+	AtkStructLayout::Cache.Empty();
+}
+
+FAtkStructLayout::FAtkStructLayout(const UScriptStruct* InStruct)
+	: Struct(InStruct)
+	, FirstProperty(InStruct->PropertyLink)
+	, Size(InStruct->GetStructureSize())
+	, Alignment(InStruct->GetMinAlignment())
+{
+	if(const UScriptStruct::ICppStructOps* CppStructOps = Struct->GetCppStructOps())
+	{
+		bPlainOldData = CppStructOps->IsPlainOldData();
+		bZeroConstructible = CppStructOps->HasZeroConstructor();
+		bNoDestructor = !CppStructOps->HasDestructor();
+	}
+	else
+	{
+		bPlainOldData = Struct->StructFlags & STRUCT_IsPlainOldData;
+		bZeroConstructible = Struct->StructFlags & STRUCT_ZeroConstructor;
+		bNoDestructor = Struct->StructFlags & STRUCT_NoDestructor;
+	}
+
+	// stable across runs, unlike the FName index
+	const FString Name = Struct->GetName().ToLower();
+	TypeSeed = CityHash64(reinterpret_cast<const char*>(*Name), Name.Len() * sizeof(TCHAR));
+
+	TArray<const FProperty*> ParentProperties;
+	TArray<const FProperty*> ChildProperties;
+	for(const FProperty* Property = Struct->PropertyLink; Property != nullptr; Property = Property->PropertyLinkNext)
+	{
+		FPropertyLayout& Layout = Properties.AddDefaulted_GetRef();
+		Layout.Property = Property;
+		Layout.Offset = Property->GetOffset_ForInternal();
+		Layout.Size = Property->GetSize();
+
+		// Check if the property is from the base struct (parent) or derived struct (child)
+		if (Property->GetOwnerStruct()->GetInheritanceSuper())
+		{
+			ChildProperties.Add(Property);
+		}
+		else
+		{
+			ParentProperties.Add(Property);
+		}
+	}
+
+	OrderedProperties.Append(ParentProperties);
+	OrderedProperties.Append(ChildProperties);
+	// Put ID property at the beginning
+	for (int32 i = 0; i < ParentProperties.Num(); ++i)
+	{
+		if (ParentProperties[i]->GetName().Contains(FString("ID")))
+		{
+			OrderedProperties.RemoveAt(i);
+			OrderedProperties.Insert(ParentProperties[i], 0);
+			break;
+		}
+	}
+
+	AtkStructLayout::BuildRuns(Properties, ComparableRuns, &FPropertyLayout::ComparableRun, &IsMemoryComparable);
+	AtkStructLayout::BuildRuns(Properties, HashableRuns, &FPropertyLayout::HashableRun, &IsMemoryHashable);
+	AtkStructLayout::BuildRuns(Properties, SerializableRuns, &FPropertyLayout::SerializableRun, &IsMemorySerializable);
+	// a native Identical operator decides equality itself, the bytes may differ for equal values
+	bFullyComparable = !(Struct->StructFlags & STRUCT_IdenticalNative) && Algo::AllOf(Properties, [](const FPropertyLayout& Layout)
+	{
+		return Layout.ComparableRun != INDEX_NONE;
+	});
+}
+
+bool FAtkStructLayout::IsUpToDate() const
+{
+	// user defined structs keep their UScriptStruct when recompiled but get new properties
+	return Struct->PropertyLink == FirstProperty && Struct->GetStructureSize() == Size;
+}
+
+void FAtkStructLayout::InitializeStruct(void* Dest, int32 Count) const
+{
+	if(bZeroConstructible)
+	{
+		FMemory::Memzero(Dest, static_cast<SIZE_T>(Size) * Count);
+		return;
+	}
+	Struct->InitializeStruct(Dest, Count);
+}
+
+void FAtkStructLayout::DestroyStruct(void* Dest, int32 Count) const
+{
+	if(bNoDestructor)
+		return;
+	
+	Struct->DestroyStruct(Dest, Count);
+}
+
+void FAtkStructLayout::CopyStruct(void* Dest, const void* Src, int32 Count) const
+{
+	if(bPlainOldData)
+	{
+		FMemory::Memcpy(Dest, Src, static_cast<SIZE_T>(Size) * Count);
+		return;
+	}
+	Struct->CopyScriptStruct(Dest, Src, Count);
+}
+
+void FAtkStructLayout::ResetStruct(void* Dest) const
+{
+	if(bZeroConstructible && bNoDestructor)
+	{
+		FMemory::Memzero(Dest, Size);
+		return;
+	}
+	Struct->ClearScriptStruct(Dest);
+}
+
+bool FAtkStructLayout::CompareStruct(const void* A, const void* B) const
+{
+	if(!bFullyComparable)
+	{
+		return Struct->CompareScriptStruct(A, B, PPF_None);
+	}
+	
+	// compare only the bytes of the properties, padding may hold anything
+	const uint8* DataA = static_cast<const uint8*>(A);
+	const uint8* DataB = static_cast<const uint8*>(B);
+	for(const FMemoryRun& Run : ComparableRuns)
+	{
+		if(FMemory::Memcmp(DataA + Run.Offset, DataB + Run.Offset, Run.Size) != 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
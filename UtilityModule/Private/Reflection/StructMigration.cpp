@@ -0,0 +1,285 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "Reflection/StructMigration.h"
+#include "Async/ParallelFor.h"
+#include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
+#include "Reflection/StructLayout.h"
+#include "UtilityModule.h"
+#include <atomic>
+
+FAtkStructMigration::FAtkStructMigration(const UScriptStruct* InSource, const UScriptStruct* InTarget)
+	: Source(InSource)
+	, Target(InTarget)
+{
+}
+
+FAtkStructMigration& FAtkStructMigration::Rename(FName SourceName, FName TargetName)
+{
+	check(!bCompiled);
+	Renames.Add(TargetName, SourceName);
+	return *this;
+}
+
+FAtkStructMigration& FAtkStructMigration::Convert(FName SourceName, FName TargetName, FConverter Converter)
+{
+	check(!bCompiled);
+	Renames.Add(TargetName, SourceName);
+	ConverterIndices.Add(TargetName, Converters.Add(MoveTemp(Converter)));
+	return *this;
+}
+
+FAtkStructMigration& FAtkStructMigration::SetDefault(FName TargetName, const FString& ValueText)
+{
+	check(!bCompiled);
+	Defaults.Add(TargetName, ValueText);
+	return *this;
+}
+
+TArray<FName> FAtkStructMigration::GetUnmappedTargetProperties() const
+{
+	return UnmappedTargetProperties;
+}
+
+FAtkStructMigration::EFieldOp FAtkStructMigration::GetFieldOp(const FProperty* SourceProperty, const FProperty* TargetProperty)
+{
+	if(SourceProperty->SameType(TargetProperty) && SourceProperty->ArrayDim == TargetProperty->ArrayDim)
+	{
+		return FAtkStructLayout::IsMemoryCopyable(SourceProperty) ? EFieldOp::Raw : EFieldOp::Copy;
+	}
+	
+	const FNumericProperty* SourceNumeric = CastField<FNumericProperty>(SourceProperty);
+	const FNumericProperty* TargetNumeric = CastField<FNumericProperty>(TargetProperty);
+	if(SourceNumeric && TargetNumeric && !SourceNumeric->IsEnum() && !TargetNumeric->IsEnum()
+		&& SourceProperty->ArrayDim == 1 && TargetProperty->ArrayDim == 1)
+	{
+		return EFieldOp::Numeric;
+	}
+	return EFieldOp::Text;
+}
+
+bool FAtkStructMigration::ReferencesObjects(const FProperty* Property, TSet<const UStruct*>& VisitedStructs)
+{
+	if(Property->IsA<FObjectPropertyBase>() || Property->IsA<FInterfaceProperty>())
+		return true;
+	
+	if(const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		bool bAlreadyVisited = false;
+		VisitedStructs.Add(StructProperty->Struct, &bAlreadyVisited);
+		if(bAlreadyVisited)
+			return false;
+		for(const FProperty* Inner = StructProperty->Struct->PropertyLink; Inner; Inner = Inner->PropertyLinkNext)
+		{
+			if(ReferencesObjects(Inner, VisitedStructs))
+				return true;
+		}
+		return false;
+	}
+	if(const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		return ReferencesObjects(ArrayProperty->Inner, VisitedStructs);
+	if(const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		return ReferencesObjects(SetProperty->ElementProp, VisitedStructs);
+	if(const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		return ReferencesObjects(MapProperty->KeyProp, VisitedStructs) || ReferencesObjects(MapProperty->ValueProp, VisitedStructs);
+	return false;
+}
+
+void FAtkStructMigration::Compile()
+{
+	if(bCompiled)
+		return;
+	bCompiled = true;
+	
+	TargetLayout = FAtkStructLayout::Get(Target);
+	if(!Source || !TargetLayout)
+		return;
+
+	TargetDefault.InitializeAs(Target);
+	for(const auto& [TargetName, ValueText] : Defaults)
+	{
+		const FProperty* Property = UAtkStructUtilsFunctionLibrary::FindPropertyByName(Target, TargetName);
+		if(!UAtkStructUtilsFunctionLibrary::SetPropertyValueFromString(Property, TargetDefault.GetMutableMemory(), ValueText))
+		{
+			UE_LOG(LogUtilityModule, Warning, TEXT("Struct migration: invalid default '%s' for %s.%s"), *ValueText, *Target->GetName(), *TargetName.ToString());
+		}
+	}
+
+	// names given to Rename and Convert can be authored or internal names, key them by target property
+	TMap<const FProperty*, FName> SourceNames;
+	TMap<const FProperty*, int32> PropertyConverters;
+	for(const auto& [TargetName, SourceName] : Renames)
+	{
+		if(const FProperty* Property = UAtkStructUtilsFunctionLibrary::FindPropertyByName(Target, TargetName))
+		{
+			SourceNames.Add(Property, SourceName);
+		}
+		else
+		{
+			UE_LOG(LogUtilityModule, Warning, TEXT("Struct migration: %s has no property %s"), *Target->GetName(), *TargetName.ToString());
+		}
+	}
+	for(const auto& [TargetName, ConverterIndex] : ConverterIndices)
+	{
+		if(const FProperty* Property = UAtkStructUtilsFunctionLibrary::FindPropertyByName(Target, TargetName))
+		{
+			PropertyConverters.Add(Property, ConverterIndex);
+		}
+	}
+
+	for(const FAtkStructLayout::FPropertyLayout& TargetField : TargetLayout->GetProperties())
+	{
+		const FName* SourceName = SourceNames.Find(TargetField.Property);
+		const FProperty* SourceProperty = UAtkStructUtilsFunctionLibrary::FindPropertyByName(Source,
+			SourceName ? *SourceName : FName(*TargetField.Property->GetAuthoredName()));
+		if(!SourceProperty)
+		{
+			UnmappedTargetProperties.Add(TargetField.Property->GetFName());
+			continue;
+		}
+
+		FField Field;
+		Field.SourceProperty = SourceProperty;
+		Field.TargetProperty = TargetField.Property;
+		Field.SourceOffset = SourceProperty->GetOffset_ForInternal();
+		Field.TargetOffset = TargetField.Offset;
+		Field.Size = TargetField.Size;
+		const int32* Converter = PropertyConverters.Find(TargetField.Property);
+		Field.Converter = Converter ? *Converter : INDEX_NONE;
+		Field.Op = Converter ? EFieldOp::Custom : GetFieldOp(SourceProperty, TargetField.Property);
+
+		// raw copies that follow each other in both structs become one copy
+		if(Field.Op == EFieldOp::Raw && Fields.Num() > 0)
+		{
+			FField& Previous = Fields.Last();
+			if(Previous.Op == EFieldOp::Raw && Previous.SourceOffset + Previous.Size == Field.SourceOffset
+				&& Previous.TargetOffset + Previous.Size == Field.TargetOffset)
+			{
+				Previous.Size += Field.Size;
+				continue;
+			}
+		}
+		if(Field.Op == EFieldOp::Text && !bTextReferencesObjects)
+		{
+			TSet<const UStruct*> VisitedStructs;
+			bTextReferencesObjects = ReferencesObjects(Field.TargetProperty, VisitedStructs);
+		}
+		Fields.Add(Field);
+	}
+
+	for(const FName& Name : UnmappedTargetProperties)
+	{
+		UE_LOG(LogUtilityModule, Verbose, TEXT("Struct migration: %s.%s has no source and keeps its default"), *Target->GetName(), *Name.ToString());
+	}
+}
+
+bool FAtkStructMigration::ApplyFields(const uint8* SourceData, uint8* TargetData) const
+{
+	bool bResult = true;
+	FString Text;
+	for(const FField& Field : Fields)
+	{
+		const uint8* SourceValue = SourceData + Field.SourceOffset;
+		uint8* TargetValue = TargetData + Field.TargetOffset;
+		switch(Field.Op)
+		{
+		case EFieldOp::Raw:
+			FMemory::Memcpy(TargetValue, SourceValue, Field.Size);
+			break;
+			
+		case EFieldOp::Copy:
+			Field.TargetProperty->CopyCompleteValue(TargetValue, SourceValue);
+			break;
+			
+		case EFieldOp::Numeric:
+		{
+			const FNumericProperty* SourceNumeric = CastFieldChecked<FNumericProperty>(Field.SourceProperty);
+			const FNumericProperty* TargetNumeric = CastFieldChecked<FNumericProperty>(Field.TargetProperty);
+			if(TargetNumeric->IsFloatingPoint())
+			{
+				TargetNumeric->SetFloatingPointPropertyValue(TargetValue, SourceNumeric->IsFloatingPoint()
+					? SourceNumeric->GetFloatingPointPropertyValue(SourceValue)
+					: static_cast<double>(SourceNumeric->GetSignedIntPropertyValue(SourceValue)));
+			}
+			else
+			{
+				TargetNumeric->SetIntPropertyValue(TargetValue, SourceNumeric->IsFloatingPoint()
+					? FMath::RoundToInt64(SourceNumeric->GetFloatingPointPropertyValue(SourceValue))
+					: SourceNumeric->GetSignedIntPropertyValue(SourceValue));
+			}
+			break;
+		}
+			
+		case EFieldOp::Custom:
+			bResult &= Converters[Field.Converter](Field.SourceProperty, SourceValue, Field.TargetProperty, TargetValue);
+			break;
+			
+		case EFieldOp::Text:
+			Text.Reset();
+			Field.SourceProperty->ExportTextItem_Direct(Text, SourceValue, nullptr, nullptr, PPF_None);
+			bResult &= UAtkStructUtilsFunctionLibrary::SetPropertyValueFromString(Field.TargetProperty, TargetData, Text);
+			break;
+		}
+	}
+	return bResult;
+}
+
+bool FAtkStructMigration::MigrateStruct(const void* SourceData, void* TargetData)
+{
+	Compile();
+	if(!SourceData || !TargetData || !TargetLayout)
+		return false;
+
+	TargetLayout->CopyStruct(TargetData, TargetDefault.GetMemory());
+	return ApplyFields(static_cast<const uint8*>(SourceData), static_cast<uint8*>(TargetData));
+}
+
+bool FAtkStructMigration::Migrate(const FInstancedStruct& SourceStruct, FInstancedStruct& OutTarget)
+{
+	Compile();
+	if(SourceStruct.GetScriptStruct() != Source || !TargetLayout)
+		return false;
+	
+	OutTarget.InitializeAs(Target, TargetDefault.GetMemory());
+	return ApplyFields(SourceStruct.GetMemory(), OutTarget.GetMutableMemory());
+}
+
+int32 FAtkStructMigration::MigrateArray(TArray<FInstancedStruct>& Structs, int32 GrainSize)
+{
+	Compile();
+	if(!TargetLayout)
+		return 0;
+
+	TArray<int32> Indices;
+	for(int32 Index = 0; Index < Structs.Num(); ++Index)
+	{
+		if(Structs[Index].GetScriptStruct() == Source)
+		{
+			Indices.Add(Index);
+		}
+	}
+
+	GrainSize = FMath::Max(GrainSize, 1);
+	const int32 NumChunks = FMath::DivideAndRoundUp(Indices.Num(), GrainSize);
+	std::atomic<int32> NumFailed = 0;
+	ParallelFor(NumChunks, [this, &Structs, &Indices, &NumFailed, GrainSize](int32 Chunk)
+	{
+		const int32 End = FMath::Min((Chunk + 1) * GrainSize, Indices.Num());
+		for(int32 i = Chunk * GrainSize; i < End; ++i)
+		{
+			FInstancedStruct& Struct = Structs[Indices[i]];
+			FInstancedStruct Migrated;
+			Migrated.InitializeAs(Target, TargetDefault.GetMemory());
+			if(!ApplyFields(Struct.GetMemory(), Migrated.GetMutableMemory()))
+			{
+				++NumFailed;
+			}
+			Struct = MoveTemp(Migrated);
+		}
+	}, NumChunks < 2 || bTextReferencesObjects ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	if(NumFailed > 0)
+	{
+		UE_LOG(LogUtilityModule, Warning, TEXT("Struct migration %s -> %s: %d structs had fields that failed to convert"),
+			*Source->GetName(), *Target->GetName(), NumFailed.load());
+	}
+	return Indices.Num();
+}
@@ -0,0 +1,632 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "Serialization/StructArrayJournal.h"
+#include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Reflection/StructLayout.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/StructRowSerializer.h"
+#include "UtilityModule.h"
+
+namespace AtkJournal
+{
+	static constexpr uint32 Magic = 0x4A4B5441; // "ATKJ"
+	static constexpr uint16 Version = 2;
+	// Snapshots are written as insert records of at most this many structs
+	static constexpr int32 SnapshotChunkSize = 1024;
+
+	enum class ERecord : uint8
+	{
+		Schema,
+		Insert,
+		Remove,
+		Swap,
+		SetProperties,
+		SetStruct,
+	};
+
+	static void WriteHeader(FArchive& Ar, uint32 Generation)
+	{
+		uint32 FileMagic = Magic;
+		uint16 FileVersion = Version;
+		Ar << FileMagic << FileVersion << Generation;
+	}
+
+	static bool ReadHeader(FArchive& Ar, uint32& OutGeneration)
+	{
+		uint32 FileMagic = 0;
+		uint16 FileVersion = 0;
+		Ar << FileMagic << FileVersion << OutGeneration;
+		return !Ar.IsError() && FileMagic == Magic && FileVersion == Version;
+	}
+
+	static FString GetTempPath(const FString& Path)
+	{
+		return Path + TEXT(".tmp");
+	}
+
+	static bool ReadGeneration(const FString& Path, uint32& OutGeneration)
+	{
+		const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path, FILEREAD_Silent));
+		return Reader && ReadHeader(*Reader, OutGeneration);
+	}
+
+	// Applies the records of a snapshot or journal to an array, holds the schemas declared by the file
+	class FDecoder
+	{
+	public:
+		// Returns false at the first record that is torn, corrupted or does not fit Structs
+		bool ApplyRecords(TConstArrayView<uint8> Data, int32 Offset, TArray<FInstancedStruct>& Structs)
+		{
+			while(Offset < Data.Num())
+			{
+				uint32 Size = 0;
+				uint32 Crc = 0;
+				if(Data.Num() - Offset < static_cast<int32>(sizeof(Size) + sizeof(Crc)))
+					return false;
+
+				FMemory::Memcpy(&Size, &Data[Offset], sizeof(Size));
+				FMemory::Memcpy(&Crc, &Data[Offset + sizeof(Size)], sizeof(Crc));
+				Offset += sizeof(Size) + sizeof(Crc);
+				if(Size > static_cast<uint32>(Data.Num() - Offset))
+					return false;
+
+				const TConstArrayView<uint8> Payload = Data.Slice(Offset, Size);
+				if(FCrc::MemCrc32(Payload.GetData(), Payload.Num()) != Crc || !ApplyRecord(Payload, Structs))
+					return false;
+				Offset += Size;
+			}
+			return true;
+		}
+
+		// A struct of a missing or changed type was read, the loaded array is missing data the files still hold
+		bool HasDroppedStructs() const { return bDroppedStructs; }
+
+	private:
+		struct FSchema
+		{
+			const UScriptStruct* Struct = nullptr;
+			// only set when the struct layout is the one the records were written with
+			TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout;
+		};
+		TArray<FSchema> Schemas;
+		bool bDroppedStructs = false;
+
+		bool ApplyRecord(TConstArrayView<uint8> Payload, TArray<FInstancedStruct>& Structs)
+		{
+			FMemoryReaderView Reader(Payload);
+			FObjectAndNameAsStringProxyArchive ProxyReader(Reader, false);
+			ERecord Type = ERecord::Schema;
+			Reader << Type;
+			switch(Type)
+			{
+			case ERecord::Schema:
+			{
+				FString Path;
+				uint64 LayoutHash = 0;
+				Reader << Path << LayoutHash;
+				FSchema& Schema = Schemas.AddDefaulted_GetRef();
+				Schema.Struct = FindObject<UScriptStruct>(nullptr, *Path);
+				if(Schema.Struct && FAtkStructRowFormat::GetLayoutHash(Schema.Struct) == LayoutHash)
+				{
+					Schema.Layout = FAtkStructLayout::Get(Schema.Struct);
+				}
+				else
+				{
+					UE_LOG(LogUtilityModule, Warning, TEXT("Struct array journal: structs of %s cannot be read, the struct is missing or its layout changed"), *Path);
+				}
+				break;
+			}
+			case ERecord::Insert:
+			{
+				int32 Index = INDEX_NONE;
+				int32 Count = 0;
+				Reader << Index << Count;
+				if(Index < 0 || Index > Structs.Num() || Count < 0 || Count > Payload.Num())
+					return false;
+
+				TArray<FInstancedStruct> Inserted;
+				Inserted.SetNum(Count);
+				for(FInstancedStruct& Struct : Inserted)
+				{
+					if(!ReadStruct(Reader, ProxyReader, Struct))
+						return false;
+				}
+				Structs.Insert(MoveTemp(Inserted), Index);
+				break;
+			}
+			case ERecord::Remove:
+			{
+				int32 Index = INDEX_NONE;
+				int32 Count = 0;
+				Reader << Index << Count;
+				if(Index < 0 || Count < 0 || Index > Structs.Num() - Count)
+					return false;
+
+				Structs.RemoveAt(Index, Count);
+				break;
+			}
+			case ERecord::Swap:
+			{
+				int32 FirstIndex = INDEX_NONE;
+				int32 SecondIndex = INDEX_NONE;
+				Reader << FirstIndex << SecondIndex;
+				if(!Structs.IsValidIndex(FirstIndex) || !Structs.IsValidIndex(SecondIndex))
+					return false;
+
+				Structs.Swap(FirstIndex, SecondIndex);
+				break;
+			}
+			case ERecord::SetProperties:
+			{
+				int32 Index = INDEX_NONE;
+				int32 SchemaIndex = INDEX_NONE;
+				int32 NumChanged = 0;
+				Reader << Index << SchemaIndex << NumChanged;
+				if(!Structs.IsValidIndex(Index) || !Schemas.IsValidIndex(SchemaIndex))
+					return false;
+
+				const FSchema& Schema = Schemas[SchemaIndex];
+				if(!Schema.Layout)
+				{
+					bDroppedStructs = true;
+					break;
+				}
+
+				FInstancedStruct& Struct = Structs[Index];
+				if(Struct.GetScriptStruct() != Schema.Struct)
+					return false;
+
+				const TConstArrayView<FAtkStructLayout::FPropertyLayout> Properties = Schema.Layout->GetProperties();
+				for(int32 i = 0; i < NumChanged; ++i)
+				{
+					int32 PropertyIndex = INDEX_NONE;
+					Reader << PropertyIndex;
+					if(!Properties.IsValidIndex(PropertyIndex))
+						return false;
+
+					const FAtkStructLayout::FPropertyLayout& Property = Properties[PropertyIndex];
+					FAtkStructRowFormat::SerializeProperty(Reader, ProxyReader, Property.Property, Struct.GetMutableMemory() + Property.Offset);
+				}
+				break;
+			}
+			case ERecord::SetStruct:
+			{
+				int32 Index = INDEX_NONE;
+				Reader << Index;
+				FInstancedStruct Struct;
+				if(!Structs.IsValidIndex(Index) || !ReadStruct(Reader, ProxyReader, Struct))
+					return false;
+
+				Structs[Index] = MoveTemp(Struct);
+				break;
+			}
+			default:
+				return false;
+			}
+			return !Reader.IsError();
+		}
+
+		bool ReadStruct(FArchive& Reader, FArchive& ProxyReader, FInstancedStruct& OutStruct)
+		{
+			int32 SchemaIndex = INDEX_NONE;
+			Reader << SchemaIndex;
+			if(SchemaIndex == INDEX_NONE)
+			{
+				OutStruct.Reset();
+				return !Reader.IsError();
+			}
+
+			int32 Size = 0;
+			Reader << Size;
+			if(!Schemas.IsValidIndex(SchemaIndex) || Size < 0 || Size > Reader.TotalSize() - Reader.Tell())
+				return false;
+
+			const int64 End = Reader.Tell() + Size;
+			const FSchema& Schema = Schemas[SchemaIndex];
+			if(!Schema.Layout)
+			{
+				// keeps the other indices right
+				bDroppedStructs = true;
+				OutStruct.Reset();
+				Reader.Seek(End);
+				return true;
+			}
+
+			OutStruct.InitializeAs(Schema.Struct);
+			FAtkStructRowFormat::SerializePayload(Reader, ProxyReader, *Schema.Layout, OutStruct.GetMutableMemory());
+			return !Reader.IsError() && Reader.Tell() == End;
+		}
+	};
+
+	// Reads the file and applies its records to Structs, returns false if the file is missing, not a journal file or stops early.
+	// bOutDroppedStructs is set when structs of a missing or changed type were skipped
+	static bool ApplyFile(const FString& Path, TArray<FInstancedStruct>& Structs, uint32& OutGeneration, bool& bOutDroppedStructs)
+	{
+		TArray<uint8> Data;
+		if(!FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent))
+			return false;
+
+		FMemoryReader HeaderReader(Data);
+		if(!ReadHeader(HeaderReader, OutGeneration))
+			return false;
+
+		FDecoder Decoder;
+		const bool bApplied = Decoder.ApplyRecords(Data, static_cast<int32>(HeaderReader.Tell()), Structs);
+		bOutDroppedStructs |= Decoder.HasDroppedStructs();
+		return bApplied;
+	}
+}
+
+// Encodes edits as framed records, declaring the schema of each struct type the first time it is written
+class FAtkStructArrayJournal::FEncoder
+{
+public:
+	// Framed records, emptied by the owner once written
+	TArray<uint8> Bytes;
+
+	// The next file declares its schemas again
+	void ResetSchemas()
+	{
+		Schemas.Reset();
+	}
+
+	void Insert(int32 Index, TConstArrayView<FInstancedStruct> Structs)
+	{
+		for(const FInstancedStruct& Struct : Structs)
+		{
+			AddSchema(Struct.GetScriptStruct());
+		}
+
+		BeginRecord(AtkJournal::ERecord::Insert);
+		int32 Count = Structs.Num();
+		PayloadWriter << Index << Count;
+		for(const FInstancedStruct& Struct : Structs)
+		{
+			WriteStruct(Struct);
+		}
+		EndRecord();
+	}
+
+	void Remove(int32 Index, int32 Count)
+	{
+		BeginRecord(AtkJournal::ERecord::Remove);
+		PayloadWriter << Index << Count;
+		EndRecord();
+	}
+
+	void Swap(int32 FirstIndex, int32 SecondIndex)
+	{
+		BeginRecord(AtkJournal::ERecord::Swap);
+		PayloadWriter << FirstIndex << SecondIndex;
+		EndRecord();
+	}
+
+	void Set(int32 Index, const FInstancedStruct& OldStruct, const FInstancedStruct& NewStruct)
+	{
+		const UScriptStruct* StructType = NewStruct.GetScriptStruct();
+		const FSchema* Schema = AddSchema(StructType);
+		if(!Schema || StructType != OldStruct.GetScriptStruct())
+		{
+			BeginRecord(AtkJournal::ERecord::SetStruct);
+			PayloadWriter << Index;
+			WriteStruct(NewStruct);
+			EndRecord();
+			return;
+		}
+
+		TBitArray<> Changed;
+		if(!UAtkStructUtilsFunctionLibrary::DiffStructs(StructType, OldStruct.GetMemory(), NewStruct.GetMemory(), Changed))
+			return;
+
+		BeginRecord(AtkJournal::ERecord::SetProperties);
+		int32 SchemaIndex = Schema->Index;
+		int32 NumChanged = Changed.CountSetBits();
+		PayloadWriter << Index << SchemaIndex << NumChanged;
+		const TConstArrayView<FAtkStructLayout::FPropertyLayout> Properties = Schema->Layout->GetProperties();
+		for(TConstSetBitIterator<> It(Changed); It; ++It)
+		{
+			int32 PropertyIndex = It.GetIndex();
+			const FAtkStructLayout::FPropertyLayout& Property = Properties[PropertyIndex];
+			PayloadWriter << PropertyIndex;
+			// Saving does not modify the struct
+			FAtkStructRowFormat::SerializeProperty(PayloadWriter, ProxyWriter, Property.Property, const_cast<uint8*>(NewStruct.GetMemory()) + Property.Offset);
+		}
+		EndRecord();
+	}
+
+private:
+	struct FSchema
+	{
+		int32 Index = INDEX_NONE;
+		TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout;
+	};
+	TMap<const UScriptStruct*, FSchema> Schemas;
+
+	// Payload of the record being encoded
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter{ Payload };
+	FObjectAndNameAsStringProxyArchive ProxyWriter{ PayloadWriter, false };
+
+	const FSchema* AddSchema(const UScriptStruct* Struct)
+	{
+		if(!Struct)
+			return nullptr;
+		if(const FSchema* Found = Schemas.Find(Struct))
+			return Found;
+
+		FSchema Schema;
+		Schema.Index = Schemas.Num();
+		Schema.Layout = FAtkStructLayout::Get(Struct);
+		BeginRecord(AtkJournal::ERecord::Schema);
+		FString Path = Struct->GetPathName();
+		uint64 LayoutHash = FAtkStructRowFormat::GetLayoutHash(Struct);
+		PayloadWriter << Path << LayoutHash;
+		EndRecord();
+		return &Schemas.Add(Struct, MoveTemp(Schema));
+	}
+
+	void BeginRecord(AtkJournal::ERecord Type)
+	{
+		Payload.Reset();
+		PayloadWriter.Seek(0);
+		PayloadWriter << Type;
+	}
+
+	void EndRecord()
+	{
+		const uint32 Size = Payload.Num();
+		const uint32 Crc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+		const int32 Offset = Bytes.AddUninitialized(sizeof(Size) + sizeof(Crc));
+		FMemory::Memcpy(&Bytes[Offset], &Size, sizeof(Size));
+		FMemory::Memcpy(&Bytes[Offset + sizeof(Size)], &Crc, sizeof(Crc));
+		Bytes.Append(Payload);
+	}
+
+	// Schema index then, for a set struct, the payload size and payload so outdated structs can be skipped
+	void WriteStruct(const FInstancedStruct& Struct)
+	{
+		const FSchema* Schema = Struct.GetScriptStruct() ? Schemas.Find(Struct.GetScriptStruct()) : nullptr;
+		int32 SchemaIndex = Schema ? Schema->Index : INDEX_NONE;
+		PayloadWriter << SchemaIndex;
+		if(!Schema)
+			return;
+
+		const int64 SizeOffset = PayloadWriter.Tell();
+		int32 Size = 0;
+		PayloadWriter << Size;
+		FAtkStructRowFormat::SerializePayload(PayloadWriter, ProxyWriter, *Schema->Layout, const_cast<uint8*>(Struct.GetMemory()));
+		const int64 End = PayloadWriter.Tell();
+		Size = static_cast<int32>(End - SizeOffset - sizeof(Size));
+		PayloadWriter.Seek(SizeOffset);
+		PayloadWriter << Size;
+		PayloadWriter.Seek(End);
+	}
+};
+
+bool FAtkStructArrayJournal::Load(const FString& BasePath, TArray<FInstancedStruct>& OutStructs)
+{
+	OutStructs.Reset();
+	const FString SnapshotPath = GetSnapshotPath(BasePath);
+	const FString TempPath = AtkJournal::GetTempPath(SnapshotPath);
+	uint32 Generation = 0;
+	bool bDroppedStructs = false;
+	if(!IFileManager::Get().FileExists(*SnapshotPath))
+	{
+		// a crash while the snapshot replaced the previous one leaves only the complete temporary file
+		if(!IFileManager::Get().FileExists(*TempPath))
+			return true;
+		if(!AtkJournal::ApplyFile(TempPath, OutStructs, Generation, bDroppedStructs))
+		{
+			UE_LOG(LogUtilityModule, Warning, TEXT("The first snapshot of %s was never completed, nothing was saved"), *BasePath);
+			OutStructs.Reset();
+			return true;
+		}
+	}
+	else if(!AtkJournal::ApplyFile(SnapshotPath, OutStructs, Generation, bDroppedStructs))
+	{
+		UE_LOG(LogUtilityModule, Error, TEXT("Error loading snapshot '%s'"), *SnapshotPath);
+		OutStructs.Reset();
+		return false;
+	}
+
+	// a journal of another generation was written before the snapshot and is already part of it
+	const FString JournalPath = GetJournalPath(BasePath);
+	uint32 JournalGeneration = 0;
+	if(AtkJournal::ReadGeneration(JournalPath, JournalGeneration) && JournalGeneration == Generation
+		&& !AtkJournal::ApplyFile(JournalPath, OutStructs, JournalGeneration, bDroppedStructs))
+	{
+		UE_LOG(LogUtilityModule, Warning, TEXT("Journal '%s' ends with a torn or invalid record, the edits after it are lost"), *JournalPath);
+	}
+
+	// a new snapshot written from this array would erase the only copy of the structs that were skipped
+	if(bDroppedStructs)
+	{
+		UE_LOG(LogUtilityModule, Error, TEXT("Error loading '%s': saved structs no longer match their type, the files are left untouched"), *BasePath);
+		OutStructs.Reset();
+		return false;
+	}
+	return true;
+}
+
+FAtkStructArrayJournal::FAtkStructArrayJournal(const FString& InBasePath, FArraySnapshot Structs)
+	: BasePath(InBasePath)
+	, Encoder(MakeUnique<FEncoder>())
+{
+	// the new snapshot must not share its generation with a journal already on disk
+	uint32 SavedGeneration = 0;
+	if(AtkJournal::ReadGeneration(GetSnapshotPath(BasePath), SavedGeneration))
+	{
+		Generation = SavedGeneration;
+	}
+	if(AtkJournal::ReadGeneration(GetJournalPath(BasePath), SavedGeneration))
+	{
+		Generation = FMath::Max(Generation, SavedGeneration);
+	}
+	Compact(MoveTemp(Structs));
+}
+
+FAtkStructArrayJournal::~FAtkStructArrayJournal()
+{
+	Flush();
+}
+
+void FAtkStructArrayJournal::AppendInsert(int32 Index, TConstArrayView<FInstancedStruct> Structs)
+{
+	if(Structs.IsEmpty())
+		return;
+
+	Encoder->Insert(Index, Structs);
+	Submit();
+}
+
+void FAtkStructArrayJournal::AppendRemove(int32 Index, int32 Count)
+{
+	if(Count <= 0)
+		return;
+
+	Encoder->Remove(Index, Count);
+	Submit();
+}
+
+void FAtkStructArrayJournal::AppendSwap(int32 FirstIndex, int32 SecondIndex)
+{
+	Encoder->Swap(FirstIndex, SecondIndex);
+	Submit();
+}
+
+void FAtkStructArrayJournal::AppendSet(int32 Index, const FInstancedStruct& OldStruct, const FInstancedStruct& NewStruct)
+{
+	Encoder->Set(Index, OldStruct, NewStruct);
+	Submit();
+}
+
+void FAtkStructArrayJournal::Compact(FArraySnapshot Structs)
+{
+	Encoder->ResetSchemas();
+	JournalSize = 0;
+
+	// object references are resolved to paths here, the structs are not referenced by the collector once handed to the writer
+	TArray<uint8> SnapshotBytes;
+	FEncoder SnapshotEncoder;
+	const TArray<FInstancedStruct>& SnapshotStructs = *Structs;
+	for(int32 Start = 0; Start < SnapshotStructs.Num(); Start += AtkJournal::SnapshotChunkSize)
+	{
+		SnapshotEncoder.Insert(Start, MakeArrayView(SnapshotStructs).Slice(Start, FMath::Min(AtkJournal::SnapshotChunkSize, SnapshotStructs.Num() - Start)));
+		SnapshotBytes.Append(SnapshotEncoder.Bytes);
+		SnapshotEncoder.Bytes.Reset();
+	}
+
+	FScopeLock Lock(&PendingLock);
+	Pending.Bytes.Reset();
+	Pending.bSnapshot = true;
+	Pending.SnapshotBytes = MoveTemp(SnapshotBytes);
+	Pending.Generation = ++Generation;
+	StartWriter();
+}
+
+void FAtkStructArrayJournal::Flush()
+{
+	UE::Tasks::FTask Task;
+	{
+		FScopeLock Lock(&PendingLock);
+		Task = WriterTask;
+	}
+	Task.Wait();
+}
+
+void FAtkStructArrayJournal::Submit()
+{
+	if(Encoder->Bytes.IsEmpty())
+		return;
+
+	JournalSize += Encoder->Bytes.Num();
+	{
+		FScopeLock Lock(&PendingLock);
+		Pending.Bytes.Append(Encoder->Bytes);
+		StartWriter();
+	}
+	Encoder->Bytes.Reset();
+}
+
+void FAtkStructArrayJournal::StartWriter()
+{
+	if(bWriterRunning)
+		return;
+
+	bWriterRunning = true;
+	WriterTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+	{
+		WritePending();
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FAtkStructArrayJournal::WritePending()
+{
+	for(;;)
+	{
+		FPendingWrite Write;
+		{
+			FScopeLock Lock(&PendingLock);
+			if(!Pending.bSnapshot && Pending.Bytes.IsEmpty())
+			{
+				bWriterRunning = false;
+				return;
+			}
+			Write = MoveTemp(Pending);
+			Pending = FPendingWrite();
+		}
+
+		if(Write.bSnapshot)
+		{
+			WriteSnapshot(Write.SnapshotBytes, Write.Generation);
+		}
+		if(JournalWriter && !Write.Bytes.IsEmpty())
+		{
+			JournalWriter->Serialize(Write.Bytes.GetData(), Write.Bytes.Num());
+			JournalWriter->Flush();
+			if(JournalWriter->IsError())
+			{
+				UE_LOG(LogUtilityModule, Error, TEXT("Failed to write journal '%s', edits are not saved until the next compaction"), *GetJournalPath(BasePath));
+				JournalWriter.Reset();
+			}
+		}
+	}
+}
+
+void FAtkStructArrayJournal::WriteSnapshot(const TArray<uint8>& SnapshotBytes, uint32 SnapshotGeneration)
+{
+	// the current journal does not apply to the new snapshot, even if writing it fails
+	JournalWriter.Reset();
+
+	const FString SnapshotPath = GetSnapshotPath(BasePath);
+	const FString TempPath = AtkJournal::GetTempPath(SnapshotPath);
+	TUniquePtr<FArchive> SnapshotWriter(IFileManager::Get().CreateFileWriter(*TempPath));
+	if(!SnapshotWriter)
+	{
+		UE_LOG(LogUtilityModule, Error, TEXT("Failed to open file for writing: %s"), *TempPath);
+		return;
+	}
+
+	AtkJournal::WriteHeader(*SnapshotWriter, SnapshotGeneration);
+	SnapshotWriter->Serialize(const_cast<uint8*>(SnapshotBytes.GetData()), SnapshotBytes.Num());
+	const bool bWritten = SnapshotWriter->Close();
+	SnapshotWriter.Reset();
+	if(!bWritten || !IFileManager::Get().Move(*SnapshotPath, *TempPath, true))
+	{
+		UE_LOG(LogUtilityModule, Error, TEXT("Failed to write snapshot '%s', edits are not saved until the next compaction"), *SnapshotPath);
+		return;
+	}
+
+	const FString JournalPath = GetJournalPath(BasePath);
+	JournalWriter.Reset(IFileManager::Get().CreateFileWriter(*JournalPath));
+	if(!JournalWriter)
+	{
+		UE_LOG(LogUtilityModule, Error, TEXT("Failed to open file for writing: %s"), *JournalPath);
+		return;
+	}
+	AtkJournal::WriteHeader(*JournalWriter, SnapshotGeneration);
+	JournalWriter->Flush();
+}
@@ -0,0 +1,258 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "Serialization/StructRowSerializer.h"
+#include "Hash/CityHash.h"
+#include "Reflection/StructLayout.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/StructuredArchiveAdapters.h"
+#include "UtilityModule.h"
+
+namespace AtkStructRow
+{
+	// Nested structs are written member by member unless they bring their own serializer
+	static bool IsWrittenByLayout(const FStructProperty* StructProperty)
+	{
+		return StructProperty && !StructProperty->Struct->UseNativeSerialization();
+	}
+
+	static uint64 HashString(const FString& String, uint64 Seed)
+	{
+		return CityHash64WithSeed(reinterpret_cast<const char*>(*String), String.Len() * sizeof(TCHAR), Seed);
+	}
+
+	static uint64 HashLayout(const FAtkStructLayout& Layout, uint64 Seed)
+	{
+		uint64 Hash = CityHash128to64({ Seed, static_cast<uint64>(Layout.GetSize()) });
+		for(const FAtkStructLayout::FPropertyLayout& Property : Layout.GetProperties())
+		{
+			Hash = HashString(Property.Property->GetName(), Hash);
+			Hash = HashString(Property.Property->GetClass()->GetName(), Hash);
+			Hash = CityHash128to64({ Hash, static_cast<uint64>(Property.Offset) << 32 | static_cast<uint32>(Property.Size) });
+			
+			const FStructProperty* StructProperty = CastField<FStructProperty>(Property.Property);
+			if(IsWrittenByLayout(StructProperty))
+			{
+				Hash = HashLayout(*FAtkStructLayout::Get(StructProperty->Struct), Hash);
+			}
+		}
+		return Hash;
+	}
+}
+
+uint64 FAtkStructRowFormat::GetLayoutHash(const UScriptStruct* Struct)
+{
+	const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = FAtkStructLayout::Get(Struct);
+	return Layout ? AtkStructRow::HashLayout(*Layout, Layout->GetTypeSeed()) : 0;
+}
+
+void FAtkStructRowFormat::SerializePayload(FArchive& Ar, FArchive& ProxyAr, const FAtkStructLayout& Layout, uint8* Data)
+{
+	const TConstArrayView<FAtkStructLayout::FPropertyLayout> Properties = Layout.GetProperties();
+	// only numbers, enums and bools are raw bytes, names and pointers mean nothing in another process
+	const TConstArrayView<FAtkStructLayout::FMemoryRun> Runs = Layout.GetSerializableRuns();
+	for(int32 Index = 0; Index < Properties.Num();)
+	{
+		const FAtkStructLayout::FPropertyLayout& Property = Properties[Index];
+		if(Property.SerializableRun != INDEX_NONE)
+		{
+			const FAtkStructLayout::FMemoryRun& Run = Runs[Property.SerializableRun];
+			Ar.Serialize(Data + Run.Offset, Run.Size);
+			Index = Run.FirstProperty + Run.NumProperties;
+			continue;
+		}
+		
+		SerializeProperty(Ar, ProxyAr, Property.Property, Data + Property.Offset);
+		++Index;
+	}
+}
+
+void FAtkStructRowFormat::SerializeProperty(FArchive& Ar, FArchive& ProxyAr, const FProperty* Property, uint8* ValuePtr)
+{
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+	const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> NestedLayout = AtkStructRow::IsWrittenByLayout(StructProperty)
+		? FAtkStructLayout::Get(StructProperty->Struct) : nullptr;
+	
+	for(int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
+	{
+		uint8* ElementPtr = ValuePtr + ArrayIndex * Property->ElementSize;
+		if(Property->IsA<FStrProperty>())
+		{
+			Ar << *reinterpret_cast<FString*>(ElementPtr);
+		}
+		else if(NestedLayout)
+		{
+			SerializePayload(Ar, ProxyAr, *NestedLayout, ElementPtr);
+		}
+		else
+		{
+			FStructuredArchiveFromArchive StructuredArchive(ProxyAr);
+			Property->SerializeItem(StructuredArchive.GetSlot(), ElementPtr, nullptr);
+		}
+	}
+}
+
+FAtkStructRowWriter::FAtkStructRowWriter(FArchive& InArchive)
+	: Archive(InArchive)
+{
+	check(Archive.IsSaving());
+	uint32 Magic = FAtkStructRowFormat::Magic;
+	uint16 Version = FAtkStructRowFormat::Version;
+	Archive << Magic << Version;
+}
+
+FAtkStructRowWriter::~FAtkStructRowWriter()
+{
+	Finish();
+}
+
+bool FAtkStructRowWriter::Write(FConstStructView Row)
+{
+	const UScriptStruct* Struct = Row.GetScriptStruct();
+	if(bFinished || !Struct || Archive.IsError())
+		return false;
+
+	int32* SchemaIndex = Schemas.Find(Struct);
+	if(!SchemaIndex)
+	{
+		SchemaIndex = &Schemas.Add(Struct, Schemas.Num());
+		FAtkStructRowFormat::ERecord Record = FAtkStructRowFormat::ERecord::Schema;
+		FString Path = Struct->GetPathName();
+		uint64 LayoutHash = FAtkStructRowFormat::GetLayoutHash(Struct);
+		Archive << Record << Path << LayoutHash;
+	}
+
+	const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = FAtkStructLayout::Get(Struct);
+	Scratch.Reset();
+	FMemoryWriter ScratchWriter(Scratch);
+	FObjectAndNameAsStringProxyArchive ProxyWriter(ScratchWriter, false);
+	// Saving does not modify the row
+	FAtkStructRowFormat::SerializePayload(ScratchWriter, ProxyWriter, *Layout, const_cast<uint8*>(Row.GetMemory()));
+
+	FAtkStructRowFormat::ERecord Record = FAtkStructRowFormat::ERecord::Row;
+	int32 PayloadSize = Scratch.Num();
+	Archive << Record << *SchemaIndex << PayloadSize;
+	Archive.Serialize(Scratch.GetData(), PayloadSize);
+	++RowCount;
+	return !Archive.IsError();
+}
+
+bool FAtkStructRowWriter::Write(const FInstancedStruct& Row)
+{
+	return Write(FConstStructView(Row.GetScriptStruct(), Row.GetMemory()));
+}
+
+int32 FAtkStructRowWriter::WriteAll(TConstArrayView<FInstancedStruct> Rows)
+{
+	int32 Written = 0;
+	for(const FInstancedStruct& Row : Rows)
+	{
+		Written += Write(Row) ? 1 : 0;
+	}
+	return Written;
+}
+
+void FAtkStructRowWriter::Finish()
+{
+	if(bFinished)
+		return;
+
+	bFinished = true;
+	FAtkStructRowFormat::ERecord Record = FAtkStructRowFormat::ERecord::End;
+	Archive << Record;
+}
+
+FAtkStructRowReader::FAtkStructRowReader(FArchive& InArchive)
+	: Archive(InArchive)
+{
+	check(Archive.IsLoading());
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	Archive << Magic << Version;
+	bValid = !Archive.IsError() && Magic == FAtkStructRowFormat::Magic && Version == FAtkStructRowFormat::Version;
+	if(!bValid)
+	{
+		UE_LOG(LogUtilityModule, Error, TEXT("Struct row stream has an unknown header (magic %x, version %d)"), Magic, Version);
+	}
+}
+
+bool FAtkStructRowReader::Read(FInstancedStruct& OutRow)
+{
+	while(bValid)
+	{
+		FAtkStructRowFormat::ERecord Record = FAtkStructRowFormat::ERecord::End;
+		Archive << Record;
+		if(Archive.IsError() || Record == FAtkStructRowFormat::ERecord::End)
+			return false;
+		
+		if(Record == FAtkStructRowFormat::ERecord::Schema)
+		{
+			bValid = ReadSchema();
+			continue;
+		}
+
+		int32 SchemaIndex = INDEX_NONE;
+		int32 PayloadSize = 0;
+		Archive << SchemaIndex << PayloadSize;
+		// a corrupted size must not allocate more than the stream can hold
+		const int64 TotalSize = Archive.TotalSize();
+		const int64 MaxPayloadSize = TotalSize >= 0 ? TotalSize - Archive.Tell() : FAtkStructRowFormat::MaxPayloadSize;
+		if(Record != FAtkStructRowFormat::ERecord::Row || !Schemas.IsValidIndex(SchemaIndex) || PayloadSize < 0 || PayloadSize > MaxPayloadSize
+			|| Archive.IsError())
+		{
+			UE_LOG(LogUtilityModule, Error, TEXT("Struct row stream is corrupted"));
+			bValid = false;
+			return false;
+		}
+
+		Scratch.SetNumUninitialized(PayloadSize, EAllowShrinking::No);
+		Archive.Serialize(Scratch.GetData(), PayloadSize);
+		
+		// Rows of outdated schemas are skipped
+		const FSchema& Schema = Schemas[SchemaIndex];
+		if(!Schema.bMatches)
+			continue;
+
+		OutRow.InitializeAs(Schema.Struct);
+		FMemoryReader ScratchReader(Scratch);
+		FObjectAndNameAsStringProxyArchive ProxyReader(ScratchReader, false);
+		FAtkStructRowFormat::SerializePayload(ScratchReader, ProxyReader, *FAtkStructLayout::Get(Schema.Struct), OutRow.GetMutableMemory());
+		if(ScratchReader.IsError() || ScratchReader.Tell() != PayloadSize)
+		{
+			UE_LOG(LogUtilityModule, Error, TEXT("Failed to read a row of %s"), *Schema.Struct->GetName());
+			bValid = false;
+			return false;
+		}
+		return true;
+	}
+	return false;
+}
+
+TArray<FInstancedStruct> FAtkStructRowReader::ReadAll()
+{
+	TArray<FInstancedStruct> Rows;
+	FInstancedStruct Row;
+	while(Read(Row))
+	{
+		Rows.Add(MoveTemp(Row));
+	}
+	return Rows;
+}
+
+bool FAtkStructRowReader::ReadSchema()
+{
+	FString Path;
+	uint64 LayoutHash = 0;
+	Archive << Path << LayoutHash;
+	if(Archive.IsError())
+		return false;
+
+	FSchema& Schema = Schemas.AddDefaulted_GetRef();
+	Schema.Struct = FindObject<UScriptStruct>(nullptr, *Path);
+	Schema.bMatches = Schema.Struct && FAtkStructRowFormat::GetLayoutHash(Schema.Struct) == LayoutHash;
+	if(!Schema.bMatches)
+	{
+		UE_LOG(LogUtilityModule, Warning, TEXT("Struct row stream: rows of %s are skipped, the struct is missing or its layout changed"), *Path);
+	}
+	return true;
+}
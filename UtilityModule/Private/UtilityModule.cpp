@@ -1,14 +1,23 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UtilityModule.h"
+#include "Reflection/StructLayout.h"
+#include "UObject/UObjectGlobals.h"
 DEFINE_LOG_CATEGORY(LogUtilityModule);
 
 void FUtilityModule::StartupModule()
 {
 	UE_LOG(LogUtilityModule, Log, TEXT("Utility module has been loaded"));
+	// reloaded structs invalidate the cached struct layouts
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		FAtkStructLayout::ClearCache();
+	});
 }
 void FUtilityModule::ShutdownModule()
 {
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FAtkStructLayout::ClearCache();
 	UE_LOG(LogUtilityModule, Log, TEXT("Utility module has been unloaded"));
 }
 	
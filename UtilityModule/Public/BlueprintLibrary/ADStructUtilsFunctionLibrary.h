@@ -5,65 +5,238 @@
 #include "UtilityModule.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Templates/Models.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
 #if UE_VERSION_NEWER_THAN(5, 4, 4)
 #include "StructUtils/InstancedStruct.h"
 #else
 #include "InstancedStruct.h"
 #endif
+#include "Async/ParallelFor.h"
+#include "ContainerWrappers/SharedDefaultStructArray.h"
+#include "ContainerWrappers/StructBuffer.h"
+#include "Diagnostics/StructDumper.h"
 #include "ADStructUtilsFunctionLibrary.generated.h"
 
+/**
+ * Compile time map from a C++ type to the FProperty class that stores it.
+ * Each trait knows how to check a property for compatibility with a single cast and how to read and write the value.
+ * CanSetValue rejects values the property type accepts in C++ but cannot hold, SetValue is only called when it passes.
+ */
 template <typename T, typename Enable = void>
 struct TPropertyTraits
 {
     using Type = void; // Default to void for unsupported types
+    static constexpr bool bSupported = false;
 };
 
-template <typename T>
-struct TPropertyTraits<T, std::enable_if_t<std::is_integral_v<T>>>
+// Types stored in a TProperty<T> subclass, read and written through the property itself
+template <typename PropertyType, typename T>
+struct TFieldPropertyTraits
 {
-    using Type = FIntProperty;
+    using Type = PropertyType;
+    static constexpr bool bSupported = true;
+
+    static bool IsCompatible(const FProperty *Property)
+    {
+        return Property && Property->IsA<PropertyType>();
+    }
+    static T GetValue(const FProperty *Property, const void *ValuePtr)
+    {
+        return static_cast<const PropertyType *>(Property)->GetPropertyValue(ValuePtr);
+    }
+    static bool CanSetValue(const FProperty *Property, const T &Value)
+    {
+        return true;
+    }
+    static void SetValue(const FProperty *Property, void *ValuePtr, const T &Value)
+    {
+        static_cast<const PropertyType *>(Property)->SetPropertyValue(ValuePtr, Value);
+    }
 };
 
-template <>
-struct TPropertyTraits<uint32>
+template <> struct TPropertyTraits<int8> : TFieldPropertyTraits<FInt8Property, int8> {};
+template <> struct TPropertyTraits<int16> : TFieldPropertyTraits<FInt16Property, int16> {};
+template <> struct TPropertyTraits<int32> : TFieldPropertyTraits<FIntProperty, int32> {};
+template <> struct TPropertyTraits<int64> : TFieldPropertyTraits<FInt64Property, int64> {};
+// a byte property that references an enum holds an enum value, read it as that enum or as TEnumAsByte
+template <> struct TPropertyTraits<uint8> : TFieldPropertyTraits<FByteProperty, uint8>
 {
-    using Type = FIntProperty;
+    static bool IsCompatible(const FProperty *Property)
+    {
+        const FByteProperty *ByteProperty = CastField<FByteProperty>(Property);
+        return ByteProperty && !ByteProperty->Enum;
+    }
 };
-
-template <>
-struct TPropertyTraits<uint8>
+template <> struct TPropertyTraits<uint16> : TFieldPropertyTraits<FUInt16Property, uint16> {};
+template <> struct TPropertyTraits<uint32> : TFieldPropertyTraits<FUInt32Property, uint32> {};
+template <> struct TPropertyTraits<uint64> : TFieldPropertyTraits<FUInt64Property, uint64> {};
+template <> struct TPropertyTraits<float> : TFieldPropertyTraits<FFloatProperty, float> {};
+template <> struct TPropertyTraits<double> : TFieldPropertyTraits<FDoubleProperty, double> {};
+// FBoolProperty reads and writes through its field mask so bitfield bools work as well
+template <> struct TPropertyTraits<bool> : TFieldPropertyTraits<FBoolProperty, bool> {};
+template <> struct TPropertyTraits<FString> : TFieldPropertyTraits<FStrProperty, FString> {};
+template <> struct TPropertyTraits<FName> : TFieldPropertyTraits<FNameProperty, FName> {};
+template <> struct TPropertyTraits<FText> : TFieldPropertyTraits<FTextProperty, FText> {};
+
+// UENUM enum classes are stored in an FEnumProperty, old style enums in an FByteProperty that references the enum
+template <typename T>
+struct TPropertyTraits<T, std::enable_if_t<std::is_enum_v<T>>>
 {
-    using Type = FIntProperty;
+    using Type = FEnumProperty;
+    static constexpr bool bSupported = true;
+
+    static bool IsCompatible(const FProperty *Property)
+    {
+        if (const FEnumProperty *EnumProperty = CastField<FEnumProperty>(Property))
+        {
+            return EnumProperty->GetUnderlyingProperty()->GetSize() == sizeof(T) && EnumProperty->GetEnum() == StaticEnum<T>();
+        }
+        if (const FByteProperty *ByteProperty = CastField<FByteProperty>(Property))
+        {
+            return sizeof(T) == sizeof(uint8) && ByteProperty->Enum && ByteProperty->Enum == StaticEnum<T>();
+        }
+        return false;
+    }
+    static T GetValue(const FProperty *Property, const void *ValuePtr)
+    {
+        return *static_cast<const T *>(ValuePtr);
+    }
+    static bool CanSetValue(const FProperty *Property, const T &Value)
+    {
+        return true;
+    }
+    static void SetValue(const FProperty *Property, void *ValuePtr, const T &Value)
+    {
+        *static_cast<T *>(ValuePtr) = Value;
+    }
 };
 
-template <>
-struct TPropertyTraits<float>
+template <typename E>
+struct TPropertyTraits<TEnumAsByte<E>>
 {
-    using Type = FFloatProperty;
+    using Type = FByteProperty;
+    static constexpr bool bSupported = true;
+
+    static bool IsCompatible(const FProperty *Property)
+    {
+        const FByteProperty *ByteProperty = CastField<FByteProperty>(Property);
+        return ByteProperty && ByteProperty->Enum && ByteProperty->Enum == StaticEnum<E>();
+    }
+    static TEnumAsByte<E> GetValue(const FProperty *Property, const void *ValuePtr)
+    {
+        return TEnumAsByte<E>(*static_cast<const uint8 *>(ValuePtr));
+    }
+    static bool CanSetValue(const FProperty *Property, const TEnumAsByte<E> &Value)
+    {
+        return true;
+    }
+    static void SetValue(const FProperty *Property, void *ValuePtr, const TEnumAsByte<E> &Value)
+    {
+        *static_cast<uint8 *>(ValuePtr) = Value.GetIntValue();
+    }
 };
 
-template <>
-struct TPropertyTraits<FString>
+// UObject pointers, the property class has to be T or a child of T
+template <typename T>
+struct TPropertyTraits<T *, std::enable_if_t<TIsDerivedFrom<T, UObject>::Value>>
 {
-    using Type = FStrProperty;
+    using Type = FObjectProperty;
+    static constexpr bool bSupported = true;
+
+    static bool IsCompatible(const FProperty *Property)
+    {
+        const FObjectProperty *ObjectProperty = CastField<FObjectProperty>(Property);
+        return ObjectProperty && ObjectProperty->PropertyClass && ObjectProperty->PropertyClass->IsChildOf(T::StaticClass());
+    }
+    static T *GetValue(const FProperty *Property, const void *ValuePtr)
+    {
+        return static_cast<T *>(static_cast<const FObjectProperty *>(Property)->GetObjectPropertyValue(ValuePtr));
+    }
+    // a T can still be the wrong type for a property declared with a child class of T
+    static bool CanSetValue(const FProperty *Property, T *const &Value)
+    {
+        return !Value || Value->IsA(static_cast<const FObjectProperty *>(Property)->PropertyClass);
+    }
+    static void SetValue(const FProperty *Property, void *ValuePtr, T *const &Value)
+    {
+        static_cast<const FObjectProperty *>(Property)->SetObjectPropertyValue(ValuePtr, Value);
+    }
 };
 
-template <>
-struct TPropertyTraits<bool>
+template <typename T>
+struct TPropertyTraits<TObjectPtr<T>> : TPropertyTraits<T *>
 {
-    using Type = FBoolProperty;
+    static TObjectPtr<T> GetValue(const FProperty *Property, const void *ValuePtr)
+    {
+        return TPropertyTraits<T *>::GetValue(Property, ValuePtr);
+    }
+    static bool CanSetValue(const FProperty *Property, const TObjectPtr<T> &Value)
+    {
+        return TPropertyTraits<T *>::CanSetValue(Property, Value.Get());
+    }
+    static void SetValue(const FProperty *Property, void *ValuePtr, const TObjectPtr<T> &Value)
+    {
+        TPropertyTraits<T *>::SetValue(Property, ValuePtr, Value.Get());
+    }
 };
 
+// USTRUCTs and the core structs resolved through TBaseStructure (FVector, FColor...) are stored in an FStructProperty.
+// Other class types (containers, soft pointers...) are left unsupported rather than failing to compile in TBaseStructure
 template <typename T>
-struct TIsDerivedFromStruct
+struct TIsPropertyStruct
 {
-    static constexpr bool Value = TIsDerivedFrom<T, UStruct>::Value;
+    static constexpr bool Value = TModels<CStaticStructProvider, T>::Value;
 };
+template <> struct TIsPropertyStruct<FVector> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FVector2D> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FVector4> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FRotator> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FQuat> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FTransform> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FPlane> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FMatrix> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FBox> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FBox2D> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FIntPoint> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FIntVector> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FLinearColor> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FColor> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FGuid> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FDateTime> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FTimespan> { static constexpr bool Value = true; };
+template <> struct TIsPropertyStruct<FSoftObjectPath> { static constexpr bool Value = true; };
 
-template <>
-struct TPropertyTraits<UScriptStruct>
+template <typename T>
+struct TPropertyTraits<T, std::enable_if_t<TIsPropertyStruct<T>::Value>>
 {
     using Type = FStructProperty;
+    static constexpr bool bSupported = true;
+
+    static bool IsCompatible(const FProperty *Property)
+    {
+        const FStructProperty *StructProperty = CastField<FStructProperty>(Property);
+        return StructProperty && StructProperty->Struct == TBaseStructure<T>::Get();
+    }
+    static const T &GetValue(const FProperty *Property, const void *ValuePtr)
+    {
+        return *static_cast<const T *>(ValuePtr);
+    }
+    static bool CanSetValue(const FProperty *Property, const T &Value)
+    {
+        return true;
+    }
+    static void SetValue(const FProperty *Property, void *ValuePtr, const T &Value)
+    {
+        *static_cast<T *>(ValuePtr) = Value;
+    }
+};
+
+template <typename T>
+struct TIsDerivedFromStruct
+{
+    static constexpr bool Value = TIsDerivedFrom<T, UStruct>::Value;
 };
 
 /**
@@ -84,14 +257,61 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Instanced Struct Utils")
     static void LogInstancedStruct(const FInstancedStruct &Struct);
 
+    // Formats and writes the structs to the log or a file on a worker thread
+    UFUNCTION(BlueprintCallable, Category = "Instanced Struct Utils")
+    static void DumpInstancedStructs(const TArray<FInstancedStruct> &Structs, const FAtkStructDumpOptions &Options);
+
     UFUNCTION(BlueprintCallable, Category = "Instanced Struct Utils")
     static bool SetPropertyValueInStruct(UPARAM(ref) FInstancedStruct &InstancedStruct, const FString &PropertyName, const FString &NewValue);
 
     UFUNCTION(BlueprintCallable, Category = "Instanced Struct Utils", DisplayName = SetValueInStruct)
     static bool SetPropertyValueNestedInStructFromString(FInstancedStruct &InstancedStruct, const FString &PropertyName, const FString &NewValue);
 
+    // Applies many (property, value) edits to the same struct, returns the number of edits that were applied
+    UFUNCTION(BlueprintCallable, Category = "Instanced Struct Utils", DisplayName = SetValuesInStruct)
+    static int32 SetPropertyValuesNestedInStructFromString(UPARAM(ref) FInstancedStruct &InstancedStruct, const TMap<FString, FString> &Values);
+    static int32 SetPropertyValuesNestedInStructFromString(FInstancedStruct &InstancedStruct, TConstArrayView<TPair<FString, FString>> Values);
+
+    // Applies one value per struct to the same property, resolving the property once per struct type
+    static int32 SetPropertyValueNestedInStructsFromString(TConstArrayView<FInstancedStruct *> InstancedStructs, const FString &PropertyName, TConstArrayView<FString> NewValues);
+
+    // Sorted indices of the structs whose property exports to Value, resolving the property once per struct type
+    static TArray<int32> FindStructsWithPropertyValue(TConstArrayView<FInstancedStruct> InstancedStructs, const FString &PropertyName, const FString &Value);
+
+    /**
+     * Parses a string into the value of a property.
+     * The parser is picked once from the property class, unknown property classes fall back to ImportText.
+     * @param Property - Property to write.
+     * @param Container - Memory of the struct or object that holds the property.
+     * @param NewValue - Value as a string.
+     * @return true if the string was a valid value for the property.
+     */
+    static bool SetPropertyValueFromString(const FProperty *Property, void *Container, const FString &NewValue);
+
+    // Parser for one property class, writes Value into the memory of the property
+    using FStringImportFunc = bool (*)(const FProperty *Property, void *ValuePtr, const FString &Value);
+    static FStringImportFunc ResolveStringImporter(const FProperty *Property);
+
+    // Copies the structs into a contiguous buffer, the type of the first valid struct decides which structs are kept
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Struct Buffer")
+    static FAtkStructBuffer MakeStructBuffer(const TArray<FInstancedStruct> &InstancedStructs);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Struct Buffer")
+    static int32 GetStructBufferNum(const FAtkStructBuffer &Buffer);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Struct Buffer")
+    static FInstancedStruct GetStructBufferElement(const FAtkStructBuffer &Buffer, int32 Index);
+
+    UFUNCTION(BlueprintCallable, Category = "Struct Buffer")
+    static bool SetStructBufferElement(UPARAM(ref) FAtkStructBuffer &Buffer, int32 Index, const FInstancedStruct &Value);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Struct Buffer")
+    static TArray<FInstancedStruct> StructBufferToArray(const FAtkStructBuffer &Buffer);
+
     static FProperty *FindPropertyByDisplayName(const UStruct *Struct, const FName &DisplayName);
     static FProperty *FindPropertyByDisplayName(const TArray<const UStruct *> &Structs, const FName &DisplayName);
+    // Exact lookup on the internal name then on the authored name, unlike FindPropertyByDisplayName which matches substrings
+    static FProperty *FindPropertyByName(const UStruct *Struct, const FName &Name);
 
     static bool IsStructOfType(const FInstancedStruct &InstancedStruct, const TArray<UScriptStruct *> &StructTypes);
 
@@ -101,6 +321,43 @@ public:
     static FString GetPropertyValueAsString(const FProperty *Property, const void *StructObject, bool &OutResult);
     static FString GetPropertyValueAsString(const FProperty *Property, const void *Data);
 
+    // Returns the path (Outer.Inner for nested structs) of every property that differs between two structs
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Instanced Struct Utils")
+    static TArray<FString> GetChangedPropertyPaths(const FInstancedStruct &OldStruct, const FInstancedStruct &NewStruct);
+
+    /**
+     * Compares two structs of the same type.
+     * Runs of plain old data properties are compared with a single memcmp, other properties with their reflected comparison.
+     * @param OutChanged - One bit per property in PropertyLink order, set if the property differs.
+     * @return true if any property differs or the struct types do not match.
+     */
+    static bool DiffInstancedStructs(const FInstancedStruct &OldStruct, const FInstancedStruct &NewStruct, TBitArray<> &OutChanged);
+    static bool DiffStructs(const UScriptStruct *StructType, const void *OldData, const void *NewData, TBitArray<> &OutChanged);
+    static bool DiffStructs(const UScriptStruct *StructType, const void *OldData, const void *NewData, TArray<FString> &OutChangedPaths, const FString &PathPrefix = FString());
+
+    // Compares two structs through their cached layout, plain old data structs are compared with memcmp
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Instanced Struct Utils")
+    static bool AreInstancedStructsEqual(const FInstancedStruct &A, const FInstancedStruct &B);
+
+    // Content hash of the struct, equal structs hash the same across runs of the program
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Instanced Struct Utils")
+    static int64 GetInstancedStructHash(const FInstancedStruct &InstancedStruct);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Instanced Struct Utils")
+    static TArray<int64> GetInstancedStructHashes(const TArray<FInstancedStruct> &InstancedStructs);
+
+    // Removes every struct that is equal to an earlier one, keeps the order of the rest. Returns the number of structs removed
+    UFUNCTION(BlueprintCallable, Category = "Instanced Struct Utils")
+    static int32 RemoveDuplicateStructs(UPARAM(ref) TArray<FInstancedStruct> &InstancedStructs);
+
+    /**
+     * Hashes the value of a struct.
+     * Plain old data members are hashed straight from memory, strings and names by their content (names ignore case).
+     * Never returns 0 so callers can use 0 as "not computed".
+     */
+    static uint64 HashStruct(const UScriptStruct *StructType, const void *Data, uint64 Seed = 0);
+    static uint64 HashPropertyValue(const FProperty *Property, const void *ValuePtr, uint64 Seed);
+
     // Iterates through all properties of a struct, pass function to perform for each property
     template <typename FuncType>
     static void ForEachProperty(const UStruct *StructType, FuncType Func)
@@ -124,6 +381,96 @@ public:
         ForEachProperty(Struct, Func);
     }
 
+    // Number of structs handled by one task of the parallel visitors
+    static constexpr int32 DefaultGrainSize = 1024;
+
+    /**
+     * Runs Func(FStructView) on every valid struct, split across the task graph in chunks of GrainSize.
+     * Structs are grouped by script struct first so a task mostly works on one type.
+     * Func runs concurrently and must only write to the struct it is given.
+     */
+    template <typename FuncType>
+    static void ParallelForEachStruct(TArrayView<FInstancedStruct> InstancedStructs, FuncType Func, int32 GrainSize = DefaultGrainSize)
+    {
+        const TArray<int32> Indices = GroupIndicesByStruct(InstancedStructs, nullptr);
+        ParallelForChunks(Indices.Num(), GrainSize, [&](int32 Start, int32 End)
+        {
+            for (int32 i = Start; i < End; ++i)
+            {
+                FInstancedStruct &InstancedStruct = InstancedStructs[Indices[i]];
+                Func(FStructView(InstancedStruct.GetScriptStruct(), InstancedStruct.GetMutableMemory()));
+            }
+        });
+    }
+    // Runs Func(T&) on every struct of type T or a child of T
+    template <typename T, typename FuncType>
+    static void ParallelForEachStructOfType(TArrayView<FInstancedStruct> InstancedStructs, FuncType Func, int32 GrainSize = DefaultGrainSize)
+    {
+        const TArray<int32> Indices = GroupIndicesByStruct(InstancedStructs, TBaseStructure<T>::Get());
+        ParallelForChunks(Indices.Num(), GrainSize, [&](int32 Start, int32 End)
+        {
+            for (int32 i = Start; i < End; ++i)
+            {
+                Func(InstancedStructs[Indices[i]].GetMutable<T>());
+            }
+        });
+    }
+    // Runs Func(T&) on every element of a buffer, T must be the buffer type or one of its parents
+    template <typename T, typename FuncType>
+    static void ParallelForEachStructOfType(FAtkStructBuffer &Buffer, FuncType Func, int32 GrainSize = DefaultGrainSize)
+    {
+        if (Buffer.IsEmpty() || !Buffer.GetScriptStruct()->IsChildOf(TBaseStructure<T>::Get()))
+            return;
+        ParallelForChunks(Buffer.Num(), GrainSize, [&](int32 Start, int32 End)
+        {
+            for (int32 i = Start; i < End; ++i)
+            {
+                Func(Buffer.Get<T>(i));
+            }
+        });
+    }
+
+    /**
+     * Parallel aggregation over every valid struct.
+     * Every chunk of GrainSize structs folds into its own copy of Init with Map(Accumulator&, FConstStructView),
+     * then the chunk results are combined in chunk order with Reduce(Result&, const Accumulator&) on the calling thread.
+     * Init must be neutral for Reduce since it seeds every chunk.
+     */
+    template <typename AccumulatorType, typename MapFuncType, typename ReduceFuncType>
+    static AccumulatorType ParallelMapReduce(TConstArrayView<FInstancedStruct> InstancedStructs, const AccumulatorType &Init,
+                                             MapFuncType Map, ReduceFuncType Reduce, int32 GrainSize = DefaultGrainSize)
+    {
+        const TArray<int32> Indices = GroupIndicesByStruct(InstancedStructs, nullptr);
+        return MapReduceChunks(Indices.Num(), GrainSize, Init, [&](AccumulatorType &Accumulator, int32 i)
+        {
+            const FInstancedStruct &InstancedStruct = InstancedStructs[Indices[i]];
+            Map(Accumulator, FConstStructView(InstancedStruct.GetScriptStruct(), InstancedStruct.GetMemory()));
+        }, Reduce);
+    }
+    // Typed aggregation with Map(Accumulator&, const T&), only visits structs of type T or a child of T
+    template <typename T, typename AccumulatorType, typename MapFuncType, typename ReduceFuncType>
+    static AccumulatorType ParallelMapReduceOfType(TConstArrayView<FInstancedStruct> InstancedStructs, const AccumulatorType &Init,
+                                                   MapFuncType Map, ReduceFuncType Reduce, int32 GrainSize = DefaultGrainSize)
+    {
+        const TArray<int32> Indices = GroupIndicesByStruct(InstancedStructs, TBaseStructure<T>::Get());
+        return MapReduceChunks(Indices.Num(), GrainSize, Init, [&](AccumulatorType &Accumulator, int32 i)
+        {
+            Map(Accumulator, InstancedStructs[Indices[i]].Get<T>());
+        }, Reduce);
+    }
+    // Typed aggregation over a buffer, T must be the buffer type or one of its parents
+    template <typename T, typename AccumulatorType, typename MapFuncType, typename ReduceFuncType>
+    static AccumulatorType ParallelMapReduceOfType(const FAtkStructBuffer &Buffer, const AccumulatorType &Init,
+                                                   MapFuncType Map, ReduceFuncType Reduce, int32 GrainSize = DefaultGrainSize)
+    {
+        if (Buffer.IsEmpty() || !Buffer.GetScriptStruct()->IsChildOf(TBaseStructure<T>::Get()))
+            return Init;
+        return MapReduceChunks(Buffer.Num(), GrainSize, Init, [&](AccumulatorType &Accumulator, int32 i)
+        {
+            Map(Accumulator, Buffer.Get<T>(i));
+        }, Reduce);
+    }
+
     template <typename T, typename V>
     static T GetPropertyValue(const FProperty *Property, const V *Object, bool &bOutResult)
     {
@@ -145,10 +492,10 @@ public:
             return T();
         }
 
+        static_assert(TPropertyTraits<T>::bSupported, "No property type stores T, see TPropertyTraits");
         bOutResult = true;
         const void *ValuePtr = Property->ContainerPtrToValuePtr<void>(Object);
-        T Result = TPropertyTypeFundamentals<T>::GetPropertyValue(ValuePtr);
-        return Result;
+        return TPropertyTraits<T>::GetValue(Property, ValuePtr);
     }
 
     template <typename T, typename V>
@@ -167,8 +514,13 @@ public:
             return false;
         }
 
+        static_assert(TPropertyTraits<T>::bSupported, "No property type stores T, see TPropertyTraits");
+        if (!TPropertyTraits<T>::CanSetValue(Property, NewValue))
+        {
+            return false;
+        }
         void *ValuePtr = Property->ContainerPtrToValuePtr<void>(Object);
-        TPropertyTypeFundamentals<T>::SetPropertyValue(ValuePtr, NewValue);
+        TPropertyTraits<T>::SetValue(Property, ValuePtr, NewValue);
         return true;
     }
     template <typename T>
@@ -197,6 +549,23 @@ public:
         return false;
     }
 
+    // Writes a property of one element of a shared default array, the element only gets its own copy when the write is valid
+    template <typename T>
+    static bool SetPropertyValueInStruct(FAtkSharedDefaultStructArray &Array, int32 Index, const FString &PropertyName, const T &NewValue)
+    {
+        if (!Array.IsValidIndex(Index))
+        {
+            return false;
+        }
+        const FProperty *Property = FindPropertyByDisplayName(Array.GetScriptStruct(Index), FName(*PropertyName));
+        if (!IsTypeCompatible<T>(Property))
+        {
+            return false;
+        }
+        return SetPropertyValue<T>(Property, Array.GetMutable(Index).GetMemory(), NewValue);
+    }
+    static bool SetPropertyValueNestedInStructFromString(FAtkSharedDefaultStructArray &Array, int32 Index, const FString &PropertyName, const FString &NewValue);
+
     template <typename T>
     static FString GetPropertyValueAsString(const T *Data, FName PropertyName)
     {
@@ -232,26 +601,65 @@ private:
 
     static FStructProp GetContainerThatHoldsProperty(const FString &PropertyName, void *StructMemory, const UScriptStruct *StructType);
 
-    template <typename T>
-    static bool IsTypeCompatible(const FProperty *Property)
+    // Location of a (possibly nested) property relative to the start of the outer struct memory
+    struct FNestedPropertyPath
     {
-        if (!Property)
-            return false;
+        const FProperty *Property = nullptr;
+        int32 ContainerOffset = 0;
+
+        bool IsValid() const
+        {
+            return Property != nullptr;
+        }
+    };
+
+    static FNestedPropertyPath FindNestedProperty(const FString &PropertyName, const UScriptStruct *StructType);
+
+    // Indices of the valid structs (of Filter or its children when set), grouped by script struct and in order inside a group
+    static TArray<int32> GroupIndicesByStruct(TConstArrayView<FInstancedStruct> InstancedStructs, const UScriptStruct *Filter);
 
-        using ExpectedPropertyType = typename TPropertyTraits<T>::Type;
-        if constexpr (std::is_same_v<ExpectedPropertyType, FStructProperty>)
+    // Calls Func(Start, End) for every chunk of GrainSize elements in parallel
+    template <typename FuncType>
+    static void ParallelForChunks(int32 Num, int32 GrainSize, FuncType &&Func)
+    {
+        GrainSize = FMath::Max(GrainSize, 1);
+        const int32 NumChunks = FMath::DivideAndRoundUp(Num, GrainSize);
+        ParallelFor(NumChunks, [&Func, Num, GrainSize](int32 Chunk)
         {
-            if (const FStructProperty *StructProperty = CastField<FStructProperty>(Property))
+            const int32 Start = Chunk * GrainSize;
+            Func(Start, FMath::Min(Start + GrainSize, Num));
+        }, NumChunks < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+    }
+
+    template <typename AccumulatorType, typename MapFuncType, typename ReduceFuncType>
+    static AccumulatorType MapReduceChunks(int32 Num, int32 GrainSize, const AccumulatorType &Init, MapFuncType &&Map, ReduceFuncType &&Reduce)
+    {
+        GrainSize = FMath::Max(GrainSize, 1);
+        TArray<AccumulatorType> Accumulators;
+        Accumulators.Init(Init, FMath::DivideAndRoundUp(Num, GrainSize));
+        ParallelForChunks(Num, GrainSize, [&Accumulators, &Map, GrainSize](int32 Start, int32 End)
+        {
+            AccumulatorType &Accumulator = Accumulators[Start / GrainSize];
+            for (int32 i = Start; i < End; ++i)
             {
-                // Ensure the struct type matches
-                return StructProperty->Struct == T::StaticStruct();
+                Map(Accumulator, i);
             }
-            return false;
+        });
+
+        AccumulatorType Result = Init;
+        for (const AccumulatorType &Accumulator : Accumulators)
+        {
+            Reduce(Result, Accumulator);
         }
-        else if constexpr (!std::is_same_v<ExpectedPropertyType, void>)
+        return Result;
+    }
+
+    template <typename T>
+    static bool IsTypeCompatible(const FProperty *Property)
+    {
+        if constexpr (TPropertyTraits<T>::bSupported)
         {
-            // For other property types (e.g., FIntProperty, FFloatProperty)
-            return CastField<ExpectedPropertyType>(Property) != nullptr;
+            return TPropertyTraits<T>::IsCompatible(Property);
         }
         else
         {
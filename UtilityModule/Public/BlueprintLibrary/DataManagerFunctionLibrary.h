@@ -11,6 +11,8 @@
 #else
 #include "InstancedStruct.h"
 #endif
+#include "ContainerWrappers/StructBuffer.h"
+#include "ContainerWrappers/TypePartitionedStructArray.h"
 #include "DataManagerFunctionLibrary.generated.h"
 
 class FJsonObject;
@@ -29,6 +31,10 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Data")
     static TArray<FInstancedStruct> GetArrayOfInstancedStructsSoft(const TSoftObjectPtr<UDataTable> DataTable);
 
+    // Copies every row of the data table into one contiguous buffer
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Data")
+    static FAtkStructBuffer GetStructBuffer(const UDataTable *DataTable);
+
     template <class T>
     static bool ReadDataTableToArray(const UDataTable *DataTable, TArray<T> &ArrayToUpdate)
     {
@@ -43,6 +49,13 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = JsonUtils)
     static void WriteInstancedStructArrayToJson(const FString &FilePath, const TArray<FInstancedStruct> &Array);
+
+    // Writes the structs in the flat binary row format, much smaller and faster to load than json
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    static bool WriteInstancedStructArrayToBinary(const FString &FilePath, const TArray<FInstancedStruct> &Array);
+    // Reads a file written by WriteInstancedStructArrayToBinary, rows whose struct layout changed since are skipped
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    static TArray<FInstancedStruct> LoadCustomDataFromBinary(const FString &FilePath);
     /**
      * @brief Writes a structure to a JSON file.
      *
@@ -124,8 +137,14 @@ public:
         return OutArray;
     }
 
-    static TArray<FInstancedStruct> LoadCustomDataFromJson(const FString &FilePath, const UScriptStruct *StructType);
-    static TArray<FInstancedStruct> LoadCustomDataFromJson(const FString &FilePath, const TArray<const UScriptStruct *> &StructTypes);
+    // bRemoveDuplicates drops records equal to an earlier record in the file (compared by content hash)
+    static TArray<FInstancedStruct> LoadCustomDataFromJson(const FString &FilePath, const UScriptStruct *StructType, bool bRemoveDuplicates = false);
+    static TArray<FInstancedStruct> LoadCustomDataFromJson(const FString &FilePath, const TArray<const UScriptStruct *> &StructTypes, bool bRemoveDuplicates = false);
+
+    // Deserializes every record straight into the buffer memory, records that fail to convert are skipped
+    static bool LoadCustomDataFromJson(const FString &FilePath, const UScriptStruct *StructType, FAtkStructBuffer &OutBuffer);
+    // Deserializes every record straight into the bucket of the first type that matches it
+    static bool LoadCustomDataFromJson(const FString &FilePath, const TArray<const UScriptStruct *> &StructTypes, FAtkTypePartitionedStructArray &OutArray);
 
     static bool DeserializeJsonToFInstancedStruct(const TSharedPtr<FJsonObject> JsonObject, const UScriptStruct *StructType, FInstancedStruct &OutInstancedStruct);
     static TSharedPtr<FJsonObject> SerializeInstancedStructToJson(const FInstancedStruct &Instance);
@@ -6,8 +6,10 @@
 #include "Misc/EngineVersionComparison.h"
 #if UE_VERSION_NEWER_THAN(5, 4, 4)
 #include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
 #else
 #include "InstancedStruct.h"
+#include "StructView.h"
 #endif
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Templates/SubclassOf.h"
@@ -38,6 +40,50 @@ public:
     static bool IsPropertyOfType(const FProperty *Property, const UStruct *Class);
     static FInstancedStruct GetStructFromProperty(const FProperty *Property, const void *Object);
 
+    // Views alias the struct inside its container, nothing is allocated or copied
+    // they stay valid as long as the container is alive and its memory does not move
+    // the name lookups match the property name exactly, pass a cached property to skip the lookup when walking many containers
+    static FConstStructView GetStructViewFromProperty(const FProperty *Property, const void *Container);
+    static FStructView GetStructViewFromProperty(const FProperty *Property, void *Container);
+    static FConstStructView GetStructViewFromPropertyInstancedStruct(const FInstancedStruct &InstancedStruct, const FName &PropertyName);
+    static FStructView GetMutableStructViewFromPropertyInstancedStruct(FInstancedStruct &InstancedStruct, const FName &PropertyName);
+    static FConstStructView GetStructViewFromPropertyObj(const UObject *Object, const FName &PropertyName);
+    static FStructView GetMutableStructViewFromPropertyObj(UObject *Object, const FName &PropertyName);
+
+    // Typed pointer to a struct property of an InstancedStruct, nullptr when the property is not a T (or a child of T)
+    template <typename T>
+    static const T *GetStructPtrFromProperty(const FInstancedStruct &InstancedStruct, const FName &PropertyName)
+    {
+        return GetStructPtrFromView<const T>(GetStructViewFromPropertyInstancedStruct(InstancedStruct, PropertyName));
+    }
+    template <typename T>
+    static T *GetMutableStructPtrFromProperty(FInstancedStruct &InstancedStruct, const FName &PropertyName)
+    {
+        return GetStructPtrFromView<T>(GetMutableStructViewFromPropertyInstancedStruct(InstancedStruct, PropertyName));
+    }
+    // Typed pointer to a struct property of a UObject, nullptr when the property is not a T (or a child of T)
+    template <typename T>
+    static const T *GetStructPtrFromProperty(const UObject *Object, const FName &PropertyName)
+    {
+        return GetStructPtrFromView<const T>(GetStructViewFromPropertyObj(Object, PropertyName));
+    }
+    template <typename T>
+    static T *GetMutableStructPtrFromProperty(UObject *Object, const FName &PropertyName)
+    {
+        return GetStructPtrFromView<T>(GetMutableStructViewFromPropertyObj(Object, PropertyName));
+    }
+    // Typed pointer to a struct property inside raw container memory (a struct of the property owner type, or an object)
+    template <typename T>
+    static const T *GetStructPtrFromProperty(const FProperty *Property, const void *Container)
+    {
+        return GetStructPtrFromView<const T>(GetStructViewFromProperty(Property, Container));
+    }
+    template <typename T>
+    static T *GetMutableStructPtrFromProperty(const FProperty *Property, void *Container)
+    {
+        return GetStructPtrFromView<T>(GetStructViewFromProperty(Property, Container));
+    }
+
     // From a InstancedStruct, get a specific property by name and return it as a T (T must inherit from UObject
     template <typename T>
     static T *GetPropertyAsObjectType(const FInstancedStruct &Struct, const FName &PropertyName)
@@ -52,6 +98,7 @@ public:
     }
 
     // From a UObject, get a specific property by name and return it as a T (T must inherit from UObject)
+    // Looks the property up on every call, use FAtkObjectPropertyAccessor when reading the same property from many objects
     template <typename T>
     static T *GetPropertyAsObjectType(const UObject *Object, const FName &PropertyName)
     {
@@ -60,7 +107,7 @@ public:
             return nullptr;
         }
 
-        FProperty *Property = UAtkStructUtilsFunctionLibrary::FindPropertyByDisplayName(Object->StaticClass(), PropertyName);
+        FProperty *Property = UAtkStructUtilsFunctionLibrary::FindPropertyByDisplayName(Object->GetClass(), PropertyName);
         return GetPropertyAs<T>(Property, T::StaticClass(), Object);
     }
 
@@ -80,6 +127,14 @@ public:
         return nullptr;
     }
 
+    template <typename T, typename ViewType>
+    static T *GetStructPtrFromView(const ViewType &View)
+    {
+        if (!View.IsValid() || !View.GetScriptStruct()->IsChildOf(TBaseStructure<std::remove_const_t<T>>::Get()))
+            return nullptr;
+        return reinterpret_cast<T *>(View.GetMemory());
+    }
+
     template <typename T>
     static T *HandleObjectProperty(const FObjectProperty *ObjectProperty, const UStruct *Class, const void *ContainerPtr)
     {
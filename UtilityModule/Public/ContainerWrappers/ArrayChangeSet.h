@@ -0,0 +1,174 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "ArrayChangeSet.generated.h"
+
+/**
+ * Changes made to a wrapped array during a batch, delivered once when the batch ends.
+ */
+USTRUCT(BlueprintType)
+struct UTILITYMODULE_API FAtkArrayChangeSet
+{
+	GENERATED_BODY()
+
+	// Indices, in the array at the end of the batch, of the elements added during the batch
+	UPROPERTY(BlueprintReadOnly, Category = "Array Change Set")
+	TArray<int32> AddedIndices;
+
+	// Indices, in the array at the end of the batch, of the elements that existed before the batch and were modified
+	UPROPERTY(BlueprintReadOnly, Category = "Array Change Set")
+	TArray<int32> ChangedIndices;
+
+	// Indices, in the array before the batch, of the elements that existed before the batch and were removed. Always sorted
+	UPROPERTY(BlueprintReadOnly, Category = "Array Change Set")
+	TArray<int32> RemovedIndices;
+
+	// The whole array was replaced or cleared, the index lists are empty and listeners should read the array again
+	UPROPERTY(BlueprintReadOnly, Category = "Array Change Set")
+	bool bReset = false;
+
+	bool IsEmpty() const
+	{
+		return AddedIndices.IsEmpty() && ChangedIndices.IsEmpty() && RemovedIndices.IsEmpty() && NumAddedSlots == 0 && NumChangedSlots == 0 && !bReset;
+	}
+	void Reset();
+	// Fills the index lists from the recorded changes, sorted
+	void Finalize();
+
+	void RecordInsert(int32 Index, int32 Count = 1);
+	void RecordRemove(int32 Index);
+	void RecordChange(int32 Index);
+	void RecordReset();
+
+private:
+	// Index before the batch of the element at each index of the array, INDEX_NONE for added elements.
+	// Only covers the array up to the last touched index, so recording a change does not shift every recorded index
+	TArray<int32> SlotOrigins;
+	TBitArray<> ChangedSlots;
+	// Elements before the batch covered by SlotOrigins, removed ones included
+	int32 NumOrigins = 0;
+	int32 NumAddedSlots = 0;
+	int32 NumChangedSlots = 0;
+
+	// Extends SlotOrigins to the first Num elements of the array
+	void TrackSlots(int32 Num);
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnArrayBatchCommitted, const FAtkArrayChangeSet &, Changes);
+
+UENUM(BlueprintType)
+enum class EAtkArrayDeltaType : uint8
+{
+	// Count elements were inserted at Index
+	Insert,
+	// Count elements were removed at Index
+	Remove,
+	// The elements at Index and OtherIndex exchanged places
+	Move,
+	// Count elements starting at Index got a new value
+	Update,
+	// The whole array was replaced or cleared
+	Reset,
+};
+
+/**
+ * One change of a wrapped array, in the order it happened, so listeners can patch their own copy or view.
+ */
+USTRUCT(BlueprintType)
+struct UTILITYMODULE_API FAtkArrayDelta
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Array Delta")
+	EAtkArrayDeltaType Type = EAtkArrayDeltaType::Reset;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Array Delta")
+	int32 Index = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Array Delta")
+	int32 Count = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Array Delta")
+	int32 OtherIndex = INDEX_NONE;
+
+	static FAtkArrayDelta Insert(int32 InIndex, int32 InCount = 1) { return Make(EAtkArrayDeltaType::Insert, InIndex, InCount); }
+	static FAtkArrayDelta Remove(int32 InIndex, int32 InCount = 1) { return Make(EAtkArrayDeltaType::Remove, InIndex, InCount); }
+	static FAtkArrayDelta Update(int32 InIndex, int32 InCount = 1) { return Make(EAtkArrayDeltaType::Update, InIndex, InCount); }
+	static FAtkArrayDelta Reset() { return Make(EAtkArrayDeltaType::Reset, 0, 0); }
+	static FAtkArrayDelta Move(int32 InIndex, int32 InOtherIndex)
+	{
+		FAtkArrayDelta Delta = Make(EAtkArrayDeltaType::Move, InIndex, 1);
+		Delta.OtherIndex = InOtherIndex;
+		return Delta;
+	}
+
+private:
+	static FAtkArrayDelta Make(EAtkArrayDeltaType InType, int32 InIndex, int32 InCount)
+	{
+		FAtkArrayDelta Delta;
+		Delta.Type = InType;
+		Delta.Index = InIndex;
+		Delta.Count = InCount;
+		return Delta;
+	}
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnArrayDelta, const FAtkArrayDelta &, Delta);
+
+/**
+ * Native listener of array deltas, receives every delta even inside batches so it can stay in sync incrementally
+ */
+class UTILITYMODULE_API IAtkArrayDeltaListener
+{
+public:
+	virtual ~IAtkArrayDeltaListener() = default;
+	virtual void OnArrayDelta(const FAtkArrayDelta& Delta) = 0;
+};
+
+/**
+ * Keeps a batch open for its lifetime, works with TArrayWrapper and the manager arrays
+ *
+ *	{
+ *		TAtkArrayBatchScope Batch(*Manager);
+ *		for(...) Manager->Add_BP(...);
+ *	} // one OnBatchCommitted
+ */
+template <typename BatchedType>
+class TAtkArrayBatchScope
+{
+public:
+	explicit TAtkArrayBatchScope(BatchedType& InBatched)
+		: Batched(InBatched)
+	{
+		Batched.BeginBatch();
+	}
+	~TAtkArrayBatchScope()
+	{
+		Batched.EndBatch();
+	}
+	UE_NONCOPYABLE(TAtkArrayBatchScope);
+
+private:
+	BatchedType& Batched;
+};
+
+/**
+ * Runs a callback on the next core ticker tick, used to close batches at the end of the frame.
+ */
+class UTILITYMODULE_API FAtkEndOfFrameCallback
+{
+public:
+	FAtkEndOfFrameCallback() = default;
+	~FAtkEndOfFrameCallback();
+	UE_NONCOPYABLE(FAtkEndOfFrameCallback);
+	
+	// Returns false, and drops Callback, when a callback is already pending
+	bool Schedule(TFunction<void()> Callback);
+	void Cancel();
+	bool IsPending() const { return Handle.IsValid(); }
+
+private:
+	FTSTicker::FDelegateHandle Handle;
+};
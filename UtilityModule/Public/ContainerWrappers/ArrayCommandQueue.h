@@ -0,0 +1,114 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+/**
+ * Lock free multi producer queue of edits for an array owned by the game thread.
+ * Any thread can enqueue, only the game thread drains, applying the edits in the order they were queued.
+ */
+template<typename T>
+class TAtkArrayCommandQueue
+{
+public:
+	enum class ECommandType : uint8
+	{
+		Add,
+		Remove,
+		SetAt,
+		SetArray,
+		Clear,
+	};
+
+	struct FCommand
+	{
+		ECommandType Type = ECommandType::Add;
+		int32 Index = INDEX_NONE;
+		T Value = T();
+		// only used by SetArray
+		TArray<T> Values;
+	};
+
+	TAtkArrayCommandQueue() = default;
+	UE_NONCOPYABLE(TAtkArrayCommandQueue);
+
+	// Thread safe. Returns true if the queue was idle, the caller must then get a drain scheduled
+	bool Enqueue(FCommand&& Command)
+	{
+		Queue.Enqueue(MoveTemp(Command));
+		return !bDrainPending.exchange(true);
+	}
+
+	bool EnqueueAdd(T Value)
+	{
+		FCommand Command;
+		Command.Value = MoveTemp(Value);
+		return Enqueue(MoveTemp(Command));
+	}
+
+	bool EnqueueRemove(T Value)
+	{
+		FCommand Command;
+		Command.Type = ECommandType::Remove;
+		Command.Value = MoveTemp(Value);
+		return Enqueue(MoveTemp(Command));
+	}
+
+	bool EnqueueSetAt(int32 Index, T Value)
+	{
+		FCommand Command;
+		Command.Type = ECommandType::SetAt;
+		Command.Index = Index;
+		Command.Value = MoveTemp(Value);
+		return Enqueue(MoveTemp(Command));
+	}
+
+	bool EnqueueSetArray(TArray<T> Values)
+	{
+		FCommand Command;
+		Command.Type = ECommandType::SetArray;
+		Command.Values = MoveTemp(Values);
+		return Enqueue(MoveTemp(Command));
+	}
+
+	bool EnqueueClear()
+	{
+		FCommand Command;
+		Command.Type = ECommandType::Clear;
+		return Enqueue(MoveTemp(Command));
+	}
+
+	/**
+	 * Game thread only. Calls Apply(FCommand&) until the queue is empty or BudgetSeconds have passed, at least one command is applied.
+	 * @return true when the queue is empty and no drain is pending anymore, false if the caller must drain again later.
+	 */
+	template<typename ApplyType>
+	bool Drain(double BudgetSeconds, ApplyType&& Apply)
+	{
+		const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+		FCommand Command;
+		while(Queue.Dequeue(Command))
+		{
+			Apply(Command);
+			if(FPlatformTime::Seconds() >= EndTime)
+				break;
+		}
+		if(!Queue.IsEmpty())
+			return false;
+
+		// a producer may have queued after the check above and seen the drain as still pending
+		bDrainPending = false;
+		return Queue.IsEmpty() || bDrainPending.exchange(true);
+	}
+
+	bool IsEmpty() const
+	{
+		return Queue.IsEmpty();
+	}
+
+private:
+	TQueue<FCommand, EQueueMode::Mpsc> Queue;
+	std::atomic<bool> bDrainPending = false;
+};
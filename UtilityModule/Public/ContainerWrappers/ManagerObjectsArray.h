@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "TemplatedArrayWrapper.h"
+#include "ArrayCommandQueue.h"
 #include "ManagerObjectsArray.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnArrayChangedSignature, UObject*, Object);
@@ -18,6 +19,7 @@ class UTILITYMODULE_API UTkManagerObjectsArray : public UObject
 public:
 	explicit UTkManagerObjectsArray(const FObjectInitializer& ObjectInitializer);
 	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
 
 	// BP exposed methods to call TArrayWrapper methods
 	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=Add)
@@ -32,9 +34,52 @@ public:
 	
 	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=Clear)
 	void Clear_BP();
+
+	// Moves the last object into Index instead of shifting, the order is not kept
+	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=RemoveAtSwap)
+	bool RemoveAtSwap_BP(const int Index);
+
+	// Removes the objects at Indices in one pass with a single batch event, invalid indices are skipped
+	// bBroadcastItems also fires the removed and delta events of each object
+	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=RemoveAtIndices)
+	int32 RemoveAtIndices_BP(const TArray<int32>& Indices, bool bBroadcastItems = false);
+
+	// Removes every object whose property has Value as text, with a single batch event
+	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=RemoveByPropertyValue)
+	int32 RemoveByPropertyValue_BP(const FName PropertyName, const FString& Value, bool bBroadcastItems = false);
+
+	// Removes every object matching Predicate(UObject*) in one pass with a single batch event
+	template<typename PredicateType>
+	int32 RemoveAllMatching(PredicateType Predicate, bool bBroadcastItems = false)
+	{
+		return ArrayWrapper.RemoveAllMatching([&Predicate](UObject* const& Object)
+		{
+			return Predicate(Object);
+		}, bBroadcastItems);
+	}
 	
+	// Copies every pointer, use Num and GetPage to read large arrays
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category=ManagerObjectsArray, DisplayName=GetArray)
 	TArray<UObject*> GetArray_BP() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category=ManagerObjectsArray, DisplayName=Num)
+	int32 Num_BP() const;
+
+	// Copies the PageSize objects of page PageIndex, the last page can be shorter
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category=ManagerObjectsArray, DisplayName=GetPage)
+	TArray<UObject*> GetPage_BP(int32 PageIndex, int32 PageSize) const;
+
+	// Read only access without copy
+	TConstArrayView<UObject*> GetView() const { return ArrayWrapper.GetView(); }
+	int32 Num() const { return ArrayWrapper.Num(); }
+
+	// O(1) immutable view of the current objects, safe to read on any thread while the manager keeps changing
+	// The snapshot does not keep the objects alive
+	TSharedRef<const TArray<UObject*>, ESPMode::ThreadSafe> GetSnapshot() const { return ArrayWrapper.GetSnapshot(); }
+
+	// Move overloads, an empty manager takes the allocation of the array
+	void AddMultiple(TArray<UObject*>&& Multiple);
+	void SetArray(TArray<UObject*>&& NewObjects);
 	
 	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=SetArray)
 	void SetArray_BP(const TArray<UObject*>& NewObjects);
@@ -42,11 +87,58 @@ public:
 	void SetAt_BP(const int Index, UObject* Object);
 	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=SetAt)
 	UObject* At_BP(const int Index);
+	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=Swap)
+	bool Swap_BP(const int FirstIndex, const int SecondIndex);
 	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=Last)
 	UObject* Last_BP();
 	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray, DisplayName=IsEmpty)
 	bool IsEmpty() const;
 
+	// Holds back the per item events until the matching EndBatch, then broadcasts OnBatchCommitted once
+	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray)
+	void BeginBatch();
+	
+	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray)
+	void EndBatch();
+	
+	// Opens a batch that is committed on the next tick, does nothing if one is already waiting
+	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray)
+	void BatchUntilEndOfFrame();
+	
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category=ManagerObjectsArray)
+	bool IsInBatch() const;
+
+	// Keeps the per item events firing inside batches
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=ManagerObjectsArray)
+	bool bBroadcastItemsInBatch = false;
+
+	UPROPERTY(BlueprintAssignable, BlueprintCallable, Category=ManagerObjectsArray)
+	FOnArrayBatchCommitted OnBatchCommitted;
+
+	// Index range of every change, AddMultiple and Swap only report the touched range instead of the whole array
+	UPROPERTY(BlueprintAssignable, BlueprintCallable, Category=ManagerObjectsArray)
+	FOnArrayDelta OnArrayDelta;
+
+	// Native listeners also get the deltas made inside batches, they are not owned by the manager
+	void AddDeltaListener(IAtkArrayDeltaListener* Listener) { ArrayWrapper.AddDeltaListener(Listener); }
+	void RemoveDeltaListener(IAtkArrayDeltaListener* Listener) { ArrayWrapper.RemoveDeltaListener(Listener); }
+
+	// Thread safe, the edits are applied in order on the game thread inside one batch, QueueDrainBudgetMs per tick
+	// Queued objects are not referenced until they are applied, the producer must keep them alive
+	void EnqueueAdd(UObject* Object);
+	void EnqueueRemove(UObject* Object);
+	void EnqueueSetAt(int32 Index, UObject* Object);
+	void EnqueueSetArray(TArray<UObject*> NewObjects);
+	void EnqueueClear();
+
+	// Applies every queued edit now, without time budget
+	UFUNCTION(BlueprintCallable, Category=ManagerObjectsArray)
+	void FlushQueue();
+
+	// Time spent applying queued edits each tick, the rest waits for the next tick
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=ManagerObjectsArray, meta=(ClampMin=0))
+	float QueueDrainBudgetMs = 2.f;
+
 	UPROPERTY(BlueprintAssignable, BlueprintCallable, Category=ManagerObjectsArray)
 	FOnArrayChangedSignature OnObjectAdded;
 	
@@ -64,4 +156,15 @@ public:
 protected:
 	TArrayWrapper<UObject*, FOnArrayChangedSignature, FOnArraySetSignature, FOnArrayClearedSignature> ArrayWrapper;
 
+	FAtkEndOfFrameCallback EndOfFrameBatch;
+
+	using FCommandQueue = TAtkArrayCommandQueue<UObject*>;
+	FCommandQueue CommandQueue;
+	FTSTicker::FDelegateHandle DrainTicker;
+	void ScheduleDrain();
+	void StartDraining();
+	// Returns true when the queue is empty
+	bool DrainQueue(double BudgetSeconds);
+	void ApplyCommand(FCommandQueue::FCommand& Command);
+
 };
@@ -0,0 +1,93 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#else
+#include "InstancedStruct.h"
+#endif
+#include "ManagerStructsArray.h"
+#include "StableChunkedArray.h"
+#include "ManagerStableStructsArray.generated.h"
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnStableStructChange, FAtkStructHandle, Handle, const FInstancedStruct &, Struct);
+
+/**
+ * Structs array addressed by handles instead of indices.
+ * Structs never move once added, so handles and the pointers returned by Find stay valid across any other edit.
+ */
+UCLASS(BlueprintType, Blueprintable, DisplayName = ManagerStableStructsArray)
+class UTILITYMODULE_API UTkManagerStableStructsArray : public UObject
+{
+	GENERATED_BODY()
+public:
+	UFUNCTION(BlueprintCallable, Category = ManagerStableStructsArray, DisplayName = Add)
+	FAtkStructHandle Add_BP(const FInstancedStruct &DataStruct);
+
+	// Inserts before Before in the order, returns an invalid handle if Before is not valid
+	UFUNCTION(BlueprintCallable, Category = ManagerStableStructsArray, DisplayName = InsertBefore)
+	FAtkStructHandle InsertBefore_BP(const FAtkStructHandle &Before, const FInstancedStruct &DataStruct);
+
+	UFUNCTION(BlueprintCallable, Category = ManagerStableStructsArray, DisplayName = Remove)
+	bool Remove_BP(const FAtkStructHandle &Handle);
+
+	UFUNCTION(BlueprintCallable, Category = ManagerStableStructsArray, DisplayName = Clear)
+	void Clear_BP();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStableStructsArray)
+	bool IsValidHandle(const FAtkStructHandle &Handle) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStableStructsArray, DisplayName = Get)
+	FInstancedStruct Get_BP(const FAtkStructHandle &Handle, bool &bFound) const;
+
+	UFUNCTION(BlueprintCallable, Category = ManagerStableStructsArray, DisplayName = Set)
+	bool Set_BP(const FAtkStructHandle &Handle, const FInstancedStruct &NewStruct);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStableStructsArray, DisplayName = Num)
+	int32 Num_BP() const;
+
+	// Copies every struct in order
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStableStructsArray, DisplayName = GetArray)
+	TArray<FInstancedStruct> GetArray_BP() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStableStructsArray, DisplayName = GetHandles)
+	TArray<FAtkStructHandle> GetHandles_BP() const;
+
+	FAtkStructHandle Add(FInstancedStruct &&DataStruct);
+
+	// Builds a StructType from Args directly in the instanced struct that is stored
+	template<typename StructType, typename... ArgsType>
+	FAtkStructHandle Emplace(ArgsType &&...Args)
+	{
+		return Add(FInstancedStruct::Make<StructType>(Forward<ArgsType>(Args)...));
+	}
+
+	// The pointer stays valid until the struct is removed, edits made through it are not broadcast
+	FInstancedStruct *Find(const FAtkStructHandle &Handle) { return Structs.Find(Handle); }
+	const FInstancedStruct *Find(const FAtkStructHandle &Handle) const { return Structs.Find(Handle); }
+
+	// Calls Func(Handle, Struct) in order
+	template<typename FuncType>
+	void ForEach(FuncType Func) const
+	{
+		Structs.ForEach(Func);
+	}
+
+	int32 Num() const { return Structs.Num(); }
+
+	UPROPERTY(BlueprintAssignable, Category = ManagerStableStructsArray)
+	FOnStableStructChange OnStructAdded;
+
+	UPROPERTY(BlueprintAssignable, Category = ManagerStableStructsArray)
+	FOnStableStructChange OnStructRemoved;
+
+	UPROPERTY(BlueprintAssignable, Category = ManagerStableStructsArray)
+	FOnStableStructChange OnStructChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = ManagerStableStructsArray)
+	FOnStructArrayClear OnArrayCleared;
+
+protected:
+	TAtkStableChunkedArray<FInstancedStruct> Structs;
+};
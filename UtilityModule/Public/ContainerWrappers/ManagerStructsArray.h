@@ -9,11 +9,15 @@
 #include "InstancedStruct.h"
 #endif
 #include "TemplatedArrayWrapper.h"
+#include "ArrayCommandQueue.h"
+#include "StructArrayHistory.h"
+#include "Serialization/StructArrayJournal.h"
 #include "ManagerStructsArray.generated.h"
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStructArrayChange, const FInstancedStruct &, Struct);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStructArraySet, const TArray<FInstancedStruct> &, Array);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStructArrayClear);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnStructChanged, const FInstancedStruct &, OldData, const FInstancedStruct &, NewData);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnStructPropertiesChanged, int32, Index, const FInstancedStruct &, NewData, const TArray<FString> &, ChangedProperties);
 
 UCLASS(BlueprintType, Blueprintable, DisplayName = ManagerStructsArray)
 class UTILITYMODULE_API UTkManagerStructsArray : public UObject
@@ -22,6 +26,10 @@ class UTILITYMODULE_API UTkManagerStructsArray : public UObject
 public:
 	UTkManagerStructsArray(const FObjectInitializer &ObjectInitializer);
 	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
+#if WITH_EDITOR
+	virtual void PostEditUndo() override;
+#endif
 
 	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray, DisplayName = Add)
 	void Add_BP(const FInstancedStruct &DataStruct);
@@ -35,9 +43,63 @@ public:
 	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray, DisplayName = Clear)
 	void Clear_BP();
 
+	// Moves the last struct into Index instead of shifting, the order is not kept
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray, DisplayName = RemoveAtSwap)
+	bool RemoveAtSwap_BP(const int Index);
+
+	// Removes the structs at Indices in one pass with a single batch event, invalid indices are skipped
+	// bBroadcastItems also fires the removed and delta events of each struct
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray, DisplayName = RemoveAtIndices)
+	int32 RemoveAtIndices_BP(const TArray<int32> &Indices, bool bBroadcastItems = false);
+
+	// Removes every struct whose property (Outer.Inner for nested structs) has Value as text, with a single batch event
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray, DisplayName = RemoveByPropertyValue)
+	int32 RemoveByPropertyValue_BP(const FString &PropertyName, const FString &Value, bool bBroadcastItems = false);
+
+	// Removes every struct matching Predicate(const FInstancedStruct&) in one pass with a single batch event
+	template<typename PredicateType>
+	int32 RemoveAllMatching(PredicateType Predicate, bool bBroadcastItems = false)
+	{
+		TArray<int32> Indices;
+		const TConstArrayView<FInstancedStruct> View = ArrayWrapper.GetView();
+		for(int32 Index = 0; Index < View.Num(); ++Index)
+		{
+			if(Predicate(View[Index]))
+				Indices.Add(Index);
+		}
+		return RemoveAtSortedIndices(Indices, bBroadcastItems);
+	}
+
+	// Copies every struct, use Num and GetPage to read large arrays
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStructsArray, DisplayName = GetArray)
 	TArray<FInstancedStruct> GetArray_BP() const;
 
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStructsArray, DisplayName = Num)
+	int32 Num_BP() const;
+
+	// Copies the PageSize structs of page PageIndex, the last page can be shorter
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStructsArray, DisplayName = GetPage)
+	TArray<FInstancedStruct> GetPage_BP(int32 PageIndex, int32 PageSize) const;
+
+	// Read only access without copy
+	TConstArrayView<FInstancedStruct> GetView() const { return ArrayWrapper.GetView(); }
+	int32 Num() const { return ArrayWrapper.Num(); }
+
+	// O(1) immutable view of the current structs, safe to read on any thread while the manager keeps changing
+	TSharedRef<const TArray<FInstancedStruct>, ESPMode::ThreadSafe> GetSnapshot() const { return ArrayWrapper.GetSnapshot(); }
+
+	// Move overloads for callers that own the structs, nothing is deep copied
+	void Add(FInstancedStruct &&DataStruct);
+	void AddMultiple(TArray<FInstancedStruct> &&DataStructs);
+	void SetArray(TArray<FInstancedStruct> &&NewStructs);
+
+	// Builds a StructType from Args directly in the instanced struct that is stored
+	template<typename StructType, typename... ArgsType>
+	void Emplace(ArgsType &&...Args)
+	{
+		Add(FInstancedStruct::Make<StructType>(Forward<ArgsType>(Args)...));
+	}
+
 	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray, DisplayName = SetArray)
 	void SetArray_BP(const TArray<FInstancedStruct> &NewStructs);
 	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray, DisplayName = At)
@@ -45,6 +107,9 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray, DisplayName = SetAt)
 	void SetAt(const int Index, const FInstancedStruct &NewStruct);
+
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray, DisplayName = Swap)
+	bool Swap_BP(const int FirstIndex, const int SecondIndex);
 	UPROPERTY(BlueprintAssignable, Category = ManagerStructsArray)
 	FOnStructArrayChange OnStructAdded;
 
@@ -60,6 +125,182 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = ManagerStructsArray)
 	FOnStructChanged OnStructChanged;
 
+	// Same as OnStructChanged but only lists the properties that changed, the diff is only computed if this is bound
+	UPROPERTY(BlueprintAssignable, Category = ManagerStructsArray)
+	FOnStructPropertiesChanged OnStructPropertiesChanged;
+
+	// Holds back the per item events until the matching EndBatch, then broadcasts OnBatchCommitted once
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void BeginBatch();
+
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void EndBatch();
+
+	// Opens a batch that is committed on the next tick, does nothing if one is already waiting
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void BatchUntilEndOfFrame();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStructsArray)
+	bool IsInBatch() const;
+
+	// Keeps the per item events firing inside batches
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ManagerStructsArray)
+	bool bBroadcastItemsInBatch = false;
+
+	UPROPERTY(BlueprintAssignable, Category = ManagerStructsArray)
+	FOnArrayBatchCommitted OnBatchCommitted;
+
+	// Index range of every change, AddMultiple and Swap only report the touched range instead of the whole array
+	UPROPERTY(BlueprintAssignable, Category = ManagerStructsArray)
+	FOnArrayDelta OnArrayDelta;
+
+	// Native listeners also get the deltas made inside batches, they are not owned by the manager
+	void AddDeltaListener(IAtkArrayDeltaListener* Listener) { ArrayWrapper.AddDeltaListener(Listener); }
+	void RemoveDeltaListener(IAtkArrayDeltaListener* Listener) { ArrayWrapper.RemoveDeltaListener(Listener); }
+
+	// Thread safe, the edits are applied in order on the game thread inside one batch, QueueDrainBudgetMs per tick
+	void EnqueueAdd(FInstancedStruct DataStruct);
+	void EnqueueRemove(FInstancedStruct DataStruct);
+	void EnqueueSetAt(int32 Index, FInstancedStruct NewStruct);
+	void EnqueueSetArray(TArray<FInstancedStruct> NewStructs);
+	void EnqueueClear();
+
+	// Applies every queued edit now, without time budget
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void FlushQueue();
+
+	// Time spent applying queued edits each tick, the rest waits for the next tick
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ManagerStructsArray, meta = (ClampMin = 0))
+	float QueueDrainBudgetMs = 2.f;
+
+	// Keeps an undo/redo history of the edits, changed structs only store the properties that differ
+	// Edits made through the reference returned by At are not recorded
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ManagerStructsArray)
+	bool bRecordHistory = false;
+
+	// The oldest edits are forgotten once the history uses more memory than this
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ManagerStructsArray, meta = (ClampMin = 0))
+	int32 HistoryMemoryBudgetKB = 16 * 1024;
+
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	bool Undo();
+
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	bool Redo();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStructsArray)
+	bool CanUndo() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStructsArray)
+	bool CanRedo() const;
+
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void ClearHistory();
+
+	// Edits made until the matching EndEditTransaction are undone and redone together
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void BeginEditTransaction();
+
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void EndEditTransaction();
+
+	/**
+	 * Saves the structs to BasePath.snapshot and streams every later edit to BasePath.journal from a background thread.
+	 * Edits made through the reference returned by At are not saved.
+	 * @param bLoad Replaces the structs with the saved snapshot and the journal replayed over it first.
+	 * @return false if the saved structs could not be read, nothing is overwritten then.
+	 */
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	bool OpenJournal(const FString &BasePath, bool bLoad = true);
+
+	// Waits for the pending writes and stops saving the edits
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void CloseJournal();
+
+	// Writes a fresh snapshot in the background and empties the journal
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void CompactJournal();
+
+	// Blocks until every edit made so far is written
+	UFUNCTION(BlueprintCallable, Category = ManagerStructsArray)
+	void FlushJournal();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = ManagerStructsArray)
+	bool IsJournalOpen() const;
+
+	// The journal is compacted into a fresh snapshot once it grows past this size, SetArray and Clear always compact it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ManagerStructsArray, meta = (ClampMin = 0))
+	int32 JournalCompactionThresholdKB = 4 * 1024;
+
+	// Index of the first struct equal to DataStruct, found through the cached content hashes
+	int32 FindIndex(const FInstancedStruct &DataStruct) const;
+
 protected:
 	TArrayWrapper<FInstancedStruct, FOnStructArrayChange, FOnStructArraySet, FOnStructArrayClear> ArrayWrapper;
+
+	// Content hash of each element, 0 while not computed. Empty when invalidated
+	mutable TArray<uint64> ElementHashes;
+	void InvalidateHashes();
+	void InvalidateHash(int32 Index);
+
+	int32 RemoveAtSortedIndices(TArray<int32> &Indices, bool bBroadcastItems);
+
+	FAtkEndOfFrameCallback EndOfFrameBatch;
+
+	FAtkStructArrayHistory History;
+	bool bApplyingHistory = false;
+#if WITH_EDITORONLY_DATA
+	// Position of History, restored by editor transactions so PostEditUndo can replay the history to it
+	UPROPERTY()
+	int32 HistoryCursor = 0;
+#endif
+
+	// Calls Record(History) if the history is recorded and the edit does not come from the history itself
+	template<typename FuncType>
+	void RecordHistory(FuncType &&Record)
+	{
+		if(!bRecordHistory || bApplyingHistory)
+			return;
+#if WITH_EDITOR
+		// lets an open FScopedTransaction save HistoryCursor
+		Modify();
+#endif
+		History.SetMemoryBudget(static_cast<SIZE_T>(FMath::Max(HistoryMemoryBudgetKB, 0)) * 1024);
+		Record(History);
+#if WITH_EDITORONLY_DATA
+		HistoryCursor = History.GetPosition();
+#endif
+	}
+
+	TUniquePtr<FAtkStructArrayJournal> Journal;
+
+	// Calls Record(Journal) if the journal is open, then compacts it when it grew past its threshold
+	// Must be called once the edit is applied, the compaction snapshot replaces the records not written yet
+	template<typename FuncType>
+	void RecordJournal(FuncType &&Record)
+	{
+		if(!Journal)
+			return;
+
+		Record(*Journal);
+		if(Journal->GetJournalSize() > static_cast<int64>(FMath::Max(JournalCompactionThresholdKB, 0)) * 1024)
+		{
+			Journal->Compact(ArrayWrapper.GetSnapshot());
+		}
+	}
+
+	friend class FAtkStructsArrayHistoryTarget;
+	void InsertStructsAt(int32 Index, TConstArrayView<FInstancedStruct> Structs);
+	void RemoveStructsAt(int32 Index, int32 Count);
+	// Applies the history until it reaches Position, inside one batch
+	void MoveHistoryTo(int32 Position);
+
+	using FCommandQueue = TAtkArrayCommandQueue<FInstancedStruct>;
+	FCommandQueue CommandQueue;
+	FTSTicker::FDelegateHandle DrainTicker;
+	void ScheduleDrain();
+	void StartDraining();
+	// Returns true when the queue is empty
+	bool DrainQueue(double BudgetSeconds);
+	void ApplyCommand(FCommandQueue::FCommand &Command);
 };
@@ -0,0 +1,63 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
+#else
+#include "InstancedStruct.h"
+#include "StructView.h"
+#endif
+
+/**
+ * Array of instanced structs where elements equal to the default share one immutable payload.
+ * An element only gets its own copy the first time it is written to (copy on write),
+ * so sparse edits over large arrays only pay memory for the elements that changed.
+ */
+class UTILITYMODULE_API FAtkSharedDefaultStructArray
+{
+public:
+	FAtkSharedDefaultStructArray() = default;
+	FAtkSharedDefaultStructArray(int32 Num, const FInstancedStruct& InDefault);
+
+	// Num elements, all sharing the default
+	void Init(int32 Num, const FInstancedStruct& InDefault);
+	// Takes the elements of an existing array, elements equal to the default or invalid release their payload
+	void InitFromArray(TArray<FInstancedStruct>&& Array, const FInstancedStruct& InDefault);
+
+	int32 Num() const { return Elements.Num(); }
+	bool IsValidIndex(int32 Index) const { return Elements.IsValidIndex(Index); }
+	const FInstancedStruct& GetDefault() const { return Default; }
+
+	// Read access never copies
+	FConstStructView Get(int32 Index) const;
+	const UScriptStruct* GetScriptStruct(int32 Index) const;
+	
+	// Write access, gives the element its own payload if it is still sharing the default
+	FStructView GetMutable(int32 Index);
+	// A value equal to the default, or an invalid one, makes the element share the default again
+	void Set(int32 Index, const FInstancedStruct& Value);
+	void Set(int32 Index, FInstancedStruct&& Value);
+	
+	void AddDefault();
+	void Add(const FInstancedStruct& Value);
+	void RemoveAt(int32 Index);
+	// Drops the payload of an element and makes it share the default again
+	void ResetToDefault(int32 Index);
+	void Empty();
+
+	bool IsShared(int32 Index) const { return !Elements[Index].IsValid(); }
+	// Number of elements that own a payload
+	int32 NumOwned() const { return NumOwnedElements; }
+	
+	// Copies every element into a plain array
+	TArray<FInstancedStruct> ToArray() const;
+
+private:
+	FInstancedStruct Default;
+	// invalid while the element shares the default
+	TArray<FInstancedStruct> Elements;
+	int32 NumOwnedElements = 0;
+};
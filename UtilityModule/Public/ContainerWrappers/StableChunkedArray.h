@@ -0,0 +1,245 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "StableChunkedArray.generated.h"
+
+/**
+ * Handle to an element of a TAtkStableChunkedArray, valid until that element is removed.
+ * The generation tells a removed element apart from the one that reused its slot.
+ */
+USTRUCT(BlueprintType)
+struct UTILITYMODULE_API FAtkStructHandle
+{
+	GENERATED_BODY()
+
+	FAtkStructHandle() = default;
+	FAtkStructHandle(int32 InSlot, int32 InGeneration)
+		: Slot(InSlot), Generation(InGeneration)
+	{}
+
+	bool IsSet() const { return Slot != INDEX_NONE; }
+
+	bool operator==(const FAtkStructHandle& Other) const
+	{
+		return Slot == Other.Slot && Generation == Other.Generation;
+	}
+
+	bool operator!=(const FAtkStructHandle& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FAtkStructHandle& Handle)
+	{
+		return HashCombine(::GetTypeHash(Handle.Slot), ::GetTypeHash(Handle.Generation));
+	}
+
+	UPROPERTY()
+	int32 Slot = INDEX_NONE;
+
+	UPROPERTY()
+	int32 Generation = 0;
+};
+
+/**
+ * Elements live in fixed size chunks that are never reallocated, so their addresses stay stable until removed.
+ * Removed slots go to a free list and are reused, a linked list over the slots keeps the insertion order.
+ * Add, insert and remove are O(1) and never move an element.
+ */
+template<typename T, int32 ChunkSize = 256>
+class TAtkStableChunkedArray
+{
+	static_assert(ChunkSize > 0, "ChunkSize must be positive");
+
+	struct FChunk
+	{
+		TTypeCompatibleBytes<T> Elements[ChunkSize];
+	};
+
+	struct FSlot
+	{
+		int32 Generation = 0;
+		// order list while alive, free list while dead
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		bool bAlive = false;
+	};
+
+	TArray<TUniquePtr<FChunk>> Chunks;
+	TArray<FSlot> Slots;
+	int32 FreeHead = INDEX_NONE;
+	int32 Head = INDEX_NONE;
+	int32 Tail = INDEX_NONE;
+	int32 NumAlive = 0;
+
+	T* GetSlotPtr(int32 Slot) const
+	{
+		return Chunks[Slot / ChunkSize]->Elements[Slot % ChunkSize].GetTypedPtr();
+	}
+
+	int32 AllocateSlot()
+	{
+		int32 Slot = FreeHead;
+		if(Slot != INDEX_NONE)
+		{
+			FreeHead = Slots[Slot].Next;
+			return Slot;
+		}
+
+		Slot = Slots.Num();
+		if(Slot % ChunkSize == 0)
+		{
+			// the elements are constructed on demand, the chunk memory is left uninitialized
+			Chunks.Emplace(new FChunk);
+		}
+		Slots.AddDefaulted();
+		return Slot;
+	}
+
+	// Links Slot in the order list before NextSlot, at the end when NextSlot is INDEX_NONE
+	void Link(int32 Slot, int32 NextSlot)
+	{
+		const int32 PrevSlot = NextSlot != INDEX_NONE ? Slots[NextSlot].Prev : Tail;
+		Slots[Slot].Prev = PrevSlot;
+		Slots[Slot].Next = NextSlot;
+		(PrevSlot != INDEX_NONE ? Slots[PrevSlot].Next : Head) = Slot;
+		(NextSlot != INDEX_NONE ? Slots[NextSlot].Prev : Tail) = Slot;
+	}
+
+	void Unlink(int32 Slot)
+	{
+		const FSlot& Meta = Slots[Slot];
+		(Meta.Prev != INDEX_NONE ? Slots[Meta.Prev].Next : Head) = Meta.Next;
+		(Meta.Next != INDEX_NONE ? Slots[Meta.Next].Prev : Tail) = Meta.Prev;
+	}
+
+	void FreeSlot(int32 Slot)
+	{
+		FSlot& Meta = Slots[Slot];
+		DestructItem(GetSlotPtr(Slot));
+		Meta.bAlive = false;
+		Meta.Generation = (Meta.Generation + 1) & MAX_int32;
+		Meta.Prev = INDEX_NONE;
+		Meta.Next = FreeHead;
+		FreeHead = Slot;
+		--NumAlive;
+	}
+
+public:
+	TAtkStableChunkedArray() = default;
+	UE_NONCOPYABLE(TAtkStableChunkedArray);
+
+	~TAtkStableChunkedArray()
+	{
+		Empty();
+	}
+
+	int32 Num() const { return NumAlive; }
+	bool IsEmpty() const { return NumAlive == 0; }
+
+	bool IsValid(const FAtkStructHandle& Handle) const
+	{
+		return Slots.IsValidIndex(Handle.Slot) && Slots[Handle.Slot].bAlive && Slots[Handle.Slot].Generation == Handle.Generation;
+	}
+
+	// Constructs the element at the end of the order
+	template<typename... ArgsType>
+	FAtkStructHandle Emplace(ArgsType&&... Args)
+	{
+		const int32 Slot = AllocateSlot();
+		new(GetSlotPtr(Slot)) T(Forward<ArgsType>(Args)...);
+		Slots[Slot].bAlive = true;
+		Link(Slot, INDEX_NONE);
+		++NumAlive;
+		return FAtkStructHandle(Slot, Slots[Slot].Generation);
+	}
+
+	// Constructs the element before Before in the order, returns an unset handle if Before is not valid
+	template<typename... ArgsType>
+	FAtkStructHandle EmplaceBefore(const FAtkStructHandle& Before, ArgsType&&... Args)
+	{
+		if(!IsValid(Before))
+		{
+			return FAtkStructHandle();
+		}
+		const int32 Slot = AllocateSlot();
+		new(GetSlotPtr(Slot)) T(Forward<ArgsType>(Args)...);
+		Slots[Slot].bAlive = true;
+		Link(Slot, Before.Slot);
+		++NumAlive;
+		return FAtkStructHandle(Slot, Slots[Slot].Generation);
+	}
+
+	bool Remove(const FAtkStructHandle& Handle)
+	{
+		if(!IsValid(Handle))
+		{
+			return false;
+		}
+		Unlink(Handle.Slot);
+		FreeSlot(Handle.Slot);
+		return true;
+	}
+
+	// Pointer stays valid until the element is removed
+	T* Find(const FAtkStructHandle& Handle)
+	{
+		return IsValid(Handle) ? GetSlotPtr(Handle.Slot) : nullptr;
+	}
+
+	const T* Find(const FAtkStructHandle& Handle) const
+	{
+		return IsValid(Handle) ? GetSlotPtr(Handle.Slot) : nullptr;
+	}
+
+	// Removes every element, the chunks are kept and the old handles stay invalid
+	void Empty()
+	{
+		for(int32 Slot = Head; Slot != INDEX_NONE;)
+		{
+			const int32 Next = Slots[Slot].Next;
+			FreeSlot(Slot);
+			Slot = Next;
+		}
+		Head = INDEX_NONE;
+		Tail = INDEX_NONE;
+	}
+
+	FAtkStructHandle GetFirst() const
+	{
+		return Head != INDEX_NONE ? FAtkStructHandle(Head, Slots[Head].Generation) : FAtkStructHandle();
+	}
+
+	// Handle of the element after Handle in the order, unset at the end or if Handle is not valid
+	FAtkStructHandle GetNext(const FAtkStructHandle& Handle) const
+	{
+		if(!IsValid(Handle))
+		{
+			return FAtkStructHandle();
+		}
+		const int32 Next = Slots[Handle.Slot].Next;
+		return Next != INDEX_NONE ? FAtkStructHandle(Next, Slots[Next].Generation) : FAtkStructHandle();
+	}
+
+	// Calls Func(Handle, Element) in order, Func must not add or remove elements
+	template<typename FuncType>
+	void ForEach(FuncType Func)
+	{
+		for(int32 Slot = Head; Slot != INDEX_NONE; Slot = Slots[Slot].Next)
+		{
+			Func(FAtkStructHandle(Slot, Slots[Slot].Generation), *GetSlotPtr(Slot));
+		}
+	}
+
+	template<typename FuncType>
+	void ForEach(FuncType Func) const
+	{
+		for(int32 Slot = Head; Slot != INDEX_NONE; Slot = Slots[Slot].Next)
+		{
+			Func(FAtkStructHandle(Slot, Slots[Slot].Generation), static_cast<const T&>(*GetSlotPtr(Slot)));
+		}
+	}
+};
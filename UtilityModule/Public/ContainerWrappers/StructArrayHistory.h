@@ -0,0 +1,126 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#else
+#include "InstancedStruct.h"
+#endif
+
+/**
+ * Undo/redo history of the edits made to an array of instanced structs.
+ * A changed struct only keeps the old and new values of the properties that differ, inserts and removes keep the structs.
+ * The oldest transactions are dropped once the history grows past its memory budget.
+ */
+class UTILITYMODULE_API FAtkStructArrayHistory
+{
+public:
+	// Receives the edits that undo or redo a transaction
+	class IEditTarget
+	{
+	public:
+		virtual ~IEditTarget() = default;
+		virtual const FInstancedStruct* GetAt(int32 Index) const = 0;
+		virtual void InsertAt(int32 Index, TConstArrayView<FInstancedStruct> Structs) = 0;
+		virtual void RemoveAt(int32 Index, int32 Count) = 0;
+		virtual void Swap(int32 FirstIndex, int32 SecondIndex) = 0;
+		virtual void SetAt(int32 Index, FInstancedStruct&& Struct) = 0;
+		virtual void SetArray(const TArray<FInstancedStruct>& Structs) = 0;
+	};
+
+	using FArraySnapshot = TSharedRef<const TArray<FInstancedStruct>, ESPMode::ThreadSafe>;
+
+	explicit FAtkStructArrayHistory(SIZE_T InMemoryBudget = 16 * 1024 * 1024);
+	UE_NONCOPYABLE(FAtkStructArrayHistory);
+
+	void SetMemoryBudget(SIZE_T InMemoryBudget);
+	SIZE_T GetMemoryBudget() const { return MemoryBudget; }
+	SIZE_T GetAllocatedSize() const { return AllocatedSize; }
+
+	// Edits recorded until the matching EndTransaction are undone together, nested transactions join the outer one
+	void BeginTransaction();
+	void EndTransaction();
+	bool IsInTransaction() const { return TransactionDepth > 0; }
+
+	void RecordInsert(int32 Index, TConstArrayView<FInstancedStruct> Structs);
+	// Structs are the removed elements, they were at Index and after
+	void RecordRemove(int32 Index, TConstArrayView<FInstancedStruct> Structs);
+	void RecordSwap(int32 FirstIndex, int32 SecondIndex);
+	void RecordSet(int32 Index, const FInstancedStruct& OldStruct, const FInstancedStruct& NewStruct);
+	// The snapshots share the storage of the arrays, nothing is copied
+	void RecordSetArray(FArraySnapshot OldStructs, FArraySnapshot NewStructs);
+
+	bool CanUndo() const { return Cursor > 0 && TransactionDepth == 0; }
+	bool CanRedo() const { return Cursor < Transactions.Num() && TransactionDepth == 0; }
+	bool Undo(IEditTarget& Target);
+	bool Redo(IEditTarget& Target);
+
+	// Transactions applied since the history was created, keeps counting past the evicted ones
+	int32 GetPosition() const { return NumEvicted + Cursor; }
+	// Oldest position Undo can go back to
+	int32 GetOldestPosition() const { return NumEvicted; }
+
+	void Reset();
+
+private:
+	// Old and new value of one property, in memory laid out like the property
+	class FPropertyDelta
+	{
+	public:
+		FPropertyDelta(const FProperty* InProperty, const void* OldContainer, const void* NewContainer);
+		FPropertyDelta(FPropertyDelta&& Other);
+		~FPropertyDelta();
+		UE_NONCOPYABLE(FPropertyDelta);
+
+		void Apply(void* Container, bool bNewValue) const;
+		SIZE_T GetAllocatedSize() const;
+
+	private:
+		const FProperty* Property = nullptr;
+		uint8* Values = nullptr;
+	};
+
+	enum class ERecordType : uint8
+	{
+		Insert,
+		Remove,
+		Swap,
+		Set,
+		SetArray,
+	};
+
+	struct FRecord
+	{
+		ERecordType Type = ERecordType::Insert;
+		int32 Index = INDEX_NONE;
+		int32 OtherIndex = INDEX_NONE;
+		// inserted or removed structs, or the old and new struct of a Set that changed the struct type
+		TArray<FInstancedStruct> Structs;
+		TArray<FPropertyDelta> Deltas;
+		TSharedPtr<const TArray<FInstancedStruct>, ESPMode::ThreadSafe> OldArray;
+		TSharedPtr<const TArray<FInstancedStruct>, ESPMode::ThreadSafe> NewArray;
+	};
+
+	struct FTransaction
+	{
+		TArray<FRecord> Records;
+		SIZE_T AllocatedSize = 0;
+	};
+
+	FRecord& AddRecord(ERecordType Type, SIZE_T RecordSize);
+	void Apply(const FRecord& Record, IEditTarget& Target, bool bUndo) const;
+	void EnforceBudget();
+
+	static SIZE_T GetStructsSize(TConstArrayView<FInstancedStruct> Structs);
+
+	TArray<FTransaction> Transactions;
+	// Transactions[0, Cursor) are applied, the rest can be redone
+	int32 Cursor = 0;
+	int32 NumEvicted = 0;
+	int32 TransactionDepth = 0;
+	bool bTransactionOpened = false;
+	SIZE_T MemoryBudget = 0;
+	SIZE_T AllocatedSize = 0;
+};
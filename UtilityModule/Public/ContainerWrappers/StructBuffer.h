@@ -0,0 +1,147 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
+#else
+#include "InstancedStruct.h"
+#include "StructView.h"
+#endif
+#include "Reflection/StructLayout.h"
+#include "StructBuffer.generated.h"
+
+/**
+ * Contiguous buffer of structs that all have the same type.
+ * One UScriptStruct plus one aligned allocation holding every element at a fixed stride,
+ * so scans walk memory linearly instead of chasing one heap pointer per element like TArray<FInstancedStruct>.
+ */
+USTRUCT(BlueprintType)
+struct UTILITYMODULE_API FAtkStructBuffer
+{
+	GENERATED_BODY()
+
+public:
+	FAtkStructBuffer() = default;
+	explicit FAtkStructBuffer(const UScriptStruct* InScriptStruct, int32 InitialCapacity = 0);
+	FAtkStructBuffer(const FAtkStructBuffer& Other);
+	FAtkStructBuffer(FAtkStructBuffer&& Other);
+	FAtkStructBuffer& operator=(const FAtkStructBuffer& Other);
+	FAtkStructBuffer& operator=(FAtkStructBuffer&& Other);
+	~FAtkStructBuffer();
+
+	// Empties the buffer and sets the type of its elements
+	void Initialize(const UScriptStruct* InScriptStruct, int32 InitialCapacity = 0);
+
+	const UScriptStruct* GetScriptStruct() const { return ScriptStruct; }
+	int32 Num() const { return NumElements; }
+	bool IsEmpty() const { return NumElements == 0; }
+	bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < NumElements; }
+	// Distance in bytes between two elements
+	int32 GetStride() const { return Stride; }
+
+	void Reserve(int32 NewCapacity);
+	// Adds Count default constructed elements, returns the index of the first one
+	int32 AddDefaulted(int32 Count = 1);
+	// Adds a copy of Value, returns INDEX_NONE if the type does not match the buffer
+	int32 Add(FConstStructView Value);
+	int32 Add(const FInstancedStruct& Value);
+	template <typename T>
+	int32 Add(const T& Value)
+	{
+		return Add(FConstStructView::Make(Value));
+	}
+	// Copies Value over an element, returns false if the type does not match the buffer
+	bool SetAt(int32 Index, FConstStructView Value);
+	// Adds every element of the matching type, returns the number of elements added
+	int32 Append(TConstArrayView<FInstancedStruct> Values);
+	
+	void RemoveAt(int32 Index);
+	// Moves the last element into the removed slot, does not keep order
+	void RemoveAtSwap(int32 Index);
+	// Destroys every element, keeps the allocation
+	void Reset();
+	// Destroys every element and frees the allocation
+	void Empty();
+
+	FStructView GetAt(int32 Index);
+	FConstStructView GetAt(int32 Index) const;
+	FStructView operator[](int32 Index) { return GetAt(Index); }
+	FConstStructView operator[](int32 Index) const { return GetAt(Index); }
+	
+	// Typed access, T must be the type of the buffer or one of its parents
+	template <typename T>
+	T& Get(int32 Index)
+	{
+		check(IsValidIndex(Index) && ScriptStruct && ScriptStruct->IsChildOf(TBaseStructure<T>::Get()));
+		return *reinterpret_cast<T*>(Memory + static_cast<SIZE_T>(Index) * Stride);
+	}
+	template <typename T>
+	const T& Get(int32 Index) const
+	{
+		check(IsValidIndex(Index) && ScriptStruct && ScriptStruct->IsChildOf(TBaseStructure<T>::Get()));
+		return *reinterpret_cast<const T*>(Memory + static_cast<SIZE_T>(Index) * Stride);
+	}
+	// The whole buffer as a typed view, T must be exactly the type of the buffer
+	template <typename T>
+	TArrayView<T> AsArrayView()
+	{
+		check(NumElements == 0 || ScriptStruct == TBaseStructure<T>::Get());
+		return TArrayView<T>(reinterpret_cast<T*>(Memory), NumElements);
+	}
+	template <typename T>
+	TConstArrayView<T> AsArrayView() const
+	{
+		check(NumElements == 0 || ScriptStruct == TBaseStructure<T>::Get());
+		return TConstArrayView<T>(reinterpret_cast<const T*>(Memory), NumElements);
+	}
+
+	uint8* GetData() { return Memory; }
+	const uint8* GetData() const { return Memory; }
+
+	FInstancedStruct GetInstancedStruct(int32 Index) const;
+	TArray<FInstancedStruct> ToArray() const;
+
+	template <typename ViewType, typename BufferType>
+	struct TIterator
+	{
+		BufferType* Buffer;
+		int32 Index;
+		ViewType operator*() const { return Buffer->GetAt(Index); }
+		TIterator& operator++() { ++Index; return *this; }
+		bool operator!=(const TIterator& Other) const { return Index != Other.Index; }
+	};
+	using FIterator = TIterator<FStructView, FAtkStructBuffer>;
+	using FConstIterator = TIterator<FConstStructView, const FAtkStructBuffer>;
+	
+	FIterator begin() { return FIterator{ this, 0 }; }
+	FIterator end() { return FIterator{ this, NumElements }; }
+	FConstIterator begin() const { return FConstIterator{ this, 0 }; }
+	FConstIterator end() const { return FConstIterator{ this, NumElements }; }
+
+	void AddStructReferencedObjects(FReferenceCollector& Collector);
+	SIZE_T GetAllocatedSize() const { return static_cast<SIZE_T>(Capacity) * Stride; }
+
+private:
+	TObjectPtr<const UScriptStruct> ScriptStruct = nullptr;
+	TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout;
+	uint8* Memory = nullptr;
+	int32 NumElements = 0;
+	int32 Capacity = 0;
+	int32 Stride = 0;
+	
+	uint8* GetElementPtr(int32 Index) const { return Memory + static_cast<SIZE_T>(Index) * Stride; }
+	void Grow(int32 MinCapacity);
+};
+
+template <>
+struct TStructOpsTypeTraits<FAtkStructBuffer> : public TStructOpsTypeTraitsBase2<FAtkStructBuffer>
+{
+	enum
+	{
+		WithCopy = true,
+		WithAddStructReferencedObjects = true,
+	};
+};
@@ -1,18 +1,146 @@
 // Copyright 2024 An@stacioDev All rights reserved.
 #pragma once
 #include "CoreMinimal.h"
+#include "Templates/EqualTo.h"
+#include "ArrayChangeSet.h"
 /**
  * Wrapper for an array that provides bindable events when the array is modified
+ * Between BeginBatch and EndBatch the per item events are held back (unless asked for) and the changes are
+ * delivered once through the batch delegate when the outermost batch ends
+ * Every change is also described by an FAtkArrayDelta sent to the native delta listeners and the delta delegate
+ * The elements are stored copy on write, GetSnapshot shares them with readers on any thread until the next edit
  */
 template<typename T, typename DelegateChange, typename DelegateArraySet, typename DelegateArrayClear>
 class TArrayWrapper
 {
 protected:
-	TArray<T> Array;
+	using FStorage = TArray<T>;
+	TSharedRef<FStorage, ESPMode::ThreadSafe> Storage = MakeShared<FStorage, ESPMode::ThreadSafe>();
 	DelegateChange* DelegateAdd;
 	DelegateChange* DelegateRemoved;
 	DelegateArraySet* DelegateSet;
 	DelegateArrayClear* DelegateClear;
+	FOnArrayBatchCommitted* DelegateBatch = nullptr;
+	FOnArrayDelta* DelegateDelta = nullptr;
+	TArray<IAtkArrayDeltaListener*> DeltaListeners;
+	FAtkArrayChangeSet PendingChanges;
+	int32 BatchDepth = 0;
+	bool bBroadcastItemsInBatch = false;
+
+	// The first edit after a snapshot was taken copies the elements, snapshots never see later edits
+	FStorage& GetMutableArray()
+	{
+		if(!Storage.IsUnique())
+		{
+			Storage = MakeShared<FStorage, ESPMode::ThreadSafe>(*Storage);
+		}
+		return *Storage;
+	}
+
+	// Replaces the storage instead of copying it when a snapshot shares it
+	FStorage& GetEmptyArray()
+	{
+		if(Storage.IsUnique())
+		{
+			Storage->Reset();
+		}
+		else
+		{
+			Storage = MakeShared<FStorage, ESPMode::ThreadSafe>();
+		}
+		return *Storage;
+	}
+
+	FAtkArrayChangeSet* GetBatchChanges()
+	{
+		return BatchDepth > 0 ? &PendingChanges : nullptr;
+	}
+
+	// Native listeners always get the delta, the delegate follows the batch rules of the per item events
+	void EmitDelta(const FAtkArrayDelta& Delta)
+	{
+		for(int32 Index = 0; Index < DeltaListeners.Num(); ++Index)
+		{
+			DeltaListeners[Index]->OnArrayDelta(Delta);
+		}
+		if(DelegateDelta && ShouldBroadcastItems())
+			DelegateDelta->Broadcast(Delta);
+	}
+
+	void OnRangeInserted(int32 Index, int32 Count)
+	{
+		if(FAtkArrayChangeSet* Changes = GetBatchChanges())
+			Changes->RecordInsert(Index, Count);
+		EmitDelta(FAtkArrayDelta::Insert(Index, Count));
+	}
+
+	// Broadcasts the stored element, the argument it was built from may have been moved
+	void OnInserted(int32 Index)
+	{
+		OnRangeInserted(Index, 1);
+		if(DelegateAdd && ShouldBroadcastItems())
+			DelegateAdd->Broadcast((*Storage)[Index]);
+	}
+
+	// Compacts the array in one pass, Indices must be sorted, unique and valid
+	// The removals reach the listeners as one batch, the item and delta events only fire when bBroadcastItems asks for them
+	void RemoveSortedIndices(TConstArrayView<int32> Indices, bool bBroadcastItems)
+	{
+		if(Indices.IsEmpty())
+			return;
+
+		BeginBatch(bBroadcastItems);
+		FStorage& Array = GetMutableArray();
+		const bool bBroadcastRemoved = DelegateRemoved && ShouldBroadcastItems();
+		TArray<T> Removed;
+		int32 Write = Indices[0];
+		int32 NextRemoved = 0;
+		for(int32 Read = Indices[0]; Read < Array.Num(); ++Read)
+		{
+			if(NextRemoved < Indices.Num() && Indices[NextRemoved] == Read)
+			{
+				++NextRemoved;
+				if(bBroadcastRemoved)
+					Removed.Add(MoveTemp(Array[Read]));
+				continue;
+			}
+			if(Write != Read)
+				Array[Write] = MoveTemp(Array[Read]);
+			++Write;
+		}
+		Array.RemoveAt(Write, Array.Num() - Write);
+
+		// contiguous runs are reported from the back so the indices stay valid when applied in order
+		for(int32 RunEnd = Indices.Num(); RunEnd > 0;)
+		{
+			int32 RunStart = RunEnd - 1;
+			while(RunStart > 0 && Indices[RunStart - 1] == Indices[RunStart] - 1)
+			{
+				--RunStart;
+			}
+			for(int32 i = RunEnd - 1; i >= RunStart; --i)
+			{
+				PendingChanges.RecordRemove(Indices[i]);
+			}
+			EmitDelta(FAtkArrayDelta::Remove(Indices[RunStart], RunEnd - RunStart));
+			RunEnd = RunStart;
+		}
+
+		for(const T& Value : Removed)
+		{
+			DelegateRemoved->Broadcast(Value);
+		}
+		EndBatch();
+	}
+
+	void OnReplaced()
+	{
+		if(FAtkArrayChangeSet* Changes = GetBatchChanges())
+			Changes->RecordReset();
+		EmitDelta(FAtkArrayDelta::Reset());
+		if(DelegateSet && ShouldBroadcastItems())
+			DelegateSet->Broadcast(*Storage);
+	}
 public:
 	TArrayWrapper() :
 		DelegateAdd(nullptr),
@@ -28,31 +156,120 @@ public:
 		DelegateSet = &SetDel;
 		DelegateClear = &ClearDel;
 	}
+
+	void SetBatchDelegate(FOnArrayBatchCommitted& BatchDel)
+	{
+		DelegateBatch = &BatchDel;
+	}
+
+	void SetDeltaDelegate(FOnArrayDelta& DeltaDel)
+	{
+		DelegateDelta = &DeltaDel;
+	}
+
+	void AddDeltaListener(IAtkArrayDeltaListener* Listener)
+	{
+		if(Listener)
+			DeltaListeners.AddUnique(Listener);
+	}
+
+	void RemoveDeltaListener(IAtkArrayDeltaListener* Listener)
+	{
+		DeltaListeners.Remove(Listener);
+	}
+
+	// Nested batches are merged into the outermost one
+	void BeginBatch(bool bInBroadcastItems = false)
+	{
+		if(BatchDepth++ == 0)
+		{
+			PendingChanges.Reset();
+			bBroadcastItemsInBatch = bInBroadcastItems;
+		}
+	}
+
+	// Returns true when the outermost batch ended
+	bool EndBatch()
+	{
+		if(BatchDepth == 0 || --BatchDepth > 0)
+		{
+			return false;
+		}
+		if(!PendingChanges.IsEmpty())
+		{
+			FAtkArrayChangeSet Changes = MoveTemp(PendingChanges);
+			PendingChanges.Reset();
+			Changes.Finalize();
+			if(DelegateBatch)
+				DelegateBatch->Broadcast(Changes);
+		}
+		return true;
+	}
+
+	bool IsInBatch() const
+	{
+		return BatchDepth > 0;
+	}
+
+	// False while a batch holds back the per item events
+	bool ShouldBroadcastItems() const
+	{
+		return BatchDepth == 0 || bBroadcastItemsInBatch;
+	}
 	
+	// Constructs the element in place from Args, returns its index
+	template<typename... ArgsType>
+	int32 Emplace(ArgsType&&... Args)
+	{
+		const int32 Index = GetMutableArray().Emplace(Forward<ArgsType>(Args)...);
+		OnInserted(Index);
+		return Index;
+	}
+
 	void Add(const T& Value)
 	{
-		Array.Emplace(Value);
-		if(DelegateAdd)
-			DelegateAdd->Broadcast(Value);
+		Emplace(Value);
 	}
-	
-	void InsertAt(int32 Index, const T& Value)
+
+	void Add(T&& Value)
+	{
+		Emplace(MoveTemp(Value));
+	}
+
+	// Constructs the element in place at Index, does nothing if Index is out of [0, Num]
+	template<typename... ArgsType>
+	bool EmplaceAt(int32 Index, ArgsType&&... Args)
 	{
-		if (Index >= 0 && Index <= Array.Num())
+		if (Index >= 0 && Index <= Num())
 		{
-			Array.Insert(Value, Index);
-			if (DelegateAdd)
-				DelegateAdd->Broadcast(Value);
+			GetMutableArray().EmplaceAt(Index, Forward<ArgsType>(Args)...);
+			OnInserted(Index);
+			return true;
 		}
+		return false;
+	}
+	
+	void InsertAt(int32 Index, const T& Value)
+	{
+		EmplaceAt(Index, Value);
+	}
+
+	void InsertAt(int32 Index, T&& Value)
+	{
+		EmplaceAt(Index, MoveTemp(Value));
 	}
 	
 	bool Pop()
 	{
-		if (!Array.IsEmpty())
+		if (!IsEmpty())
 		{
-			T RemovedValue = Array.Last();
+			FStorage& Array = GetMutableArray();
+			T RemovedValue = MoveTemp(Array.Last());
 			Array.Pop();
-			if (DelegateRemoved)
+			if(FAtkArrayChangeSet* Changes = GetBatchChanges())
+				Changes->RecordRemove(Array.Num());
+			EmitDelta(FAtkArrayDelta::Remove(Array.Num()));
+			if (DelegateRemoved && ShouldBroadcastItems())
 				DelegateRemoved->Broadcast(RemovedValue);
 			return true;
 		}
@@ -63,9 +280,13 @@ public:
 	{
 		if (ValidIndex(FirstIndex) && ValidIndex(SecondIndex))
 		{
-			Array.Swap(FirstIndex, SecondIndex);
-			if (DelegateSet)
-				DelegateSet->Broadcast(Array);
+			GetMutableArray().Swap(FirstIndex, SecondIndex);
+			if(FAtkArrayChangeSet* Changes = GetBatchChanges())
+			{
+				Changes->RecordChange(FirstIndex);
+				Changes->RecordChange(SecondIndex);
+			}
+			EmitDelta(FAtkArrayDelta::Move(FirstIndex, SecondIndex));
 			return true;
 		}
 		return false;
@@ -75,22 +296,25 @@ public:
 	{
 		if(ValidIndex(Index))
 		{
-			return &Array[Index];
+			return &GetMutableArray()[Index];
 		}
 		return nullptr;
 	}
 
 	bool Remove(const T& Value)
 	{
-		const int32 Index = Array.IndexOfByPredicate([Value](const T& Element)
+		const int32 Index = Storage->IndexOfByPredicate([&Value](const T& Element)
 		{
 			return Element == Value;
 		});
 		
 		if (Index != INDEX_NONE)
 		{
-			Array.RemoveAt(Index);
-			if(DelegateRemoved)
+			GetMutableArray().RemoveAt(Index);
+			if(FAtkArrayChangeSet* Changes = GetBatchChanges())
+				Changes->RecordRemove(Index);
+			EmitDelta(FAtkArrayDelta::Remove(Index));
+			if(DelegateRemoved && ShouldBroadcastItems())
 				DelegateRemoved->Broadcast(Value);
 
 			return true;
@@ -98,58 +322,198 @@ public:
 		return false;
 	}
 
+	bool RemoveAt(const int32 Index)
+	{
+		if (!ValidIndex(Index))
+		{
+			return false;
+		}
+		
+		FStorage& Array = GetMutableArray();
+		T RemovedValue = MoveTemp(Array[Index]);
+		Array.RemoveAt(Index);
+		if(FAtkArrayChangeSet* Changes = GetBatchChanges())
+			Changes->RecordRemove(Index);
+		EmitDelta(FAtkArrayDelta::Remove(Index));
+		if(DelegateRemoved && ShouldBroadcastItems())
+			DelegateRemoved->Broadcast(RemovedValue);
+		return true;
+	}
+
+	// Moves the last element into Index, O(1) but does not keep the order
+	bool RemoveAtSwap(const int32 Index)
+	{
+		if (!ValidIndex(Index))
+		{
+			return false;
+		}
+
+		FStorage& Array = GetMutableArray();
+		const int32 LastIndex = Array.Num() - 1;
+		T RemovedValue = MoveTemp(Array[Index]);
+		Array.RemoveAtSwap(Index);
+		if(FAtkArrayChangeSet* Changes = GetBatchChanges())
+		{
+			if(Index != LastIndex)
+				Changes->RecordChange(Index);
+			Changes->RecordRemove(LastIndex);
+		}
+		if(Index != LastIndex)
+			EmitDelta(FAtkArrayDelta::Move(Index, LastIndex));
+		EmitDelta(FAtkArrayDelta::Remove(LastIndex));
+		if(DelegateRemoved && ShouldBroadcastItems())
+			DelegateRemoved->Broadcast(RemovedValue);
+		return true;
+	}
+
+	// Removes every element matching Predicate in one pass and notifies once, returns the number removed
+	// The per item events are held back unless bBroadcastItems is set
+	template<typename PredicateType>
+	int32 RemoveAllMatching(PredicateType Predicate, bool bBroadcastItems = false)
+	{
+		TArray<int32> Indices;
+		const FStorage& Array = *Storage;
+		for(int32 Index = 0; Index < Array.Num(); ++Index)
+		{
+			if(Predicate(Array[Index]))
+				Indices.Add(Index);
+		}
+		RemoveSortedIndices(Indices, bBroadcastItems);
+		return Indices.Num();
+	}
+
+	// Invalid and duplicated indices are ignored, Indices is left sorted and filtered to what was removed
+	// The per item events are held back unless bBroadcastItems is set
+	int32 RemoveAtIndices(TArray<int32>& Indices, bool bBroadcastItems = false)
+	{
+		Indices.Sort();
+		int32 Write = 0;
+		for(int32 Read = 0; Read < Indices.Num(); ++Read)
+		{
+			if(ValidIndex(Indices[Read]) && (Write == 0 || Indices[Write - 1] != Indices[Read]))
+				Indices[Write++] = Indices[Read];
+		}
+		Indices.SetNum(Write);
+		RemoveSortedIndices(Indices, bBroadcastItems);
+		return Indices.Num();
+	}
+
 	void Clear()
 	{
-		Array.Empty();
-		if(DelegateClear)
+		GetEmptyArray().Empty();
+		if(FAtkArrayChangeSet* Changes = GetBatchChanges())
+			Changes->RecordReset();
+		EmitDelta(FAtkArrayDelta::Reset());
+		if(DelegateClear && ShouldBroadcastItems())
 			DelegateClear->Broadcast();
 	}
 
 	void Set(const TArray<T>& Value)
 	{
-		Array = Value;
-		if(DelegateSet)
-			DelegateSet->Broadcast(Value);
+		GetEmptyArray() = Value;
+		OnReplaced();
 	}
 
+	// Takes the allocation of Value, Value is left empty
+	void Set(TArray<T>&& Value)
+	{
+		GetEmptyArray() = MoveTemp(Value);
+		OnReplaced();
+	}
+
+	// Copies the whole array, prefer GetView/GetRef to read
 	TArray<T> Get() const
 	{
-		return Array;
+		return *Storage;
+	}
+
+	const TArray<T>& GetRef() const
+	{
+		return *Storage;
+	}
+
+	TConstArrayView<T> GetView() const
+	{
+		return *Storage;
 	}
 
+	// O(1), the snapshot keeps the current elements alive and unchanged and can be read from any thread
+	TSharedRef<const TArray<T>, ESPMode::ThreadSafe> GetSnapshot() const
+	{
+		return Storage;
+	}
+
+	// Copies Count elements starting at Start, clamped to the array
+	TArray<T> GetRange(int32 Start, int32 Count) const
+	{
+		Start = FMath::Clamp(Start, 0, Storage->Num());
+		Count = FMath::Clamp(Count, 0, Storage->Num() - Start);
+		return TArray<T>(Storage->GetData() + Start, Count);
+	}
+
+	int32 Num() const
+	{
+		return Storage->Num();
+	}
+
+	// Read only range-for support
+	auto begin() const { return GetRef().begin(); }
+	auto end() const { return GetRef().end(); }
+
 	void AddMultiple(const TArray<T>& Value)
 	{
-		Array.Append(Value);
-		if(DelegateSet)
-			DelegateSet->Broadcast(Array);
+		const int32 FirstIndex = Num();
+		GetMutableArray().Append(Value);
+		OnRangeInserted(FirstIndex, Value.Num());
+	}
+
+	// Moves the elements of Value, an empty wrapper takes the whole allocation
+	void AddMultiple(TArray<T>&& Value)
+	{
+		const int32 FirstIndex = Num();
+		const int32 Count = Value.Num();
+		if(IsEmpty())
+		{
+			GetEmptyArray() = MoveTemp(Value);
+		}
+		else
+		{
+			GetMutableArray().Append(MoveTemp(Value));
+		}
+		OnRangeInserted(FirstIndex, Count);
 	}
 
-	bool SetAt(const int Index, const T& Value)
+	// Equals decides if the new value is a change, defaults to operator==
+	template<typename EqualsType = TEqualTo<T>, typename ValueType = const T&>
+	bool SetAt(const int Index, ValueType&& Value, EqualsType Equals = EqualsType())
 	{
 		if(!ValidIndex(Index))
 		{
 			return false;
 		}
-		if(Value != Array[Index])
+		if(!Equals(Value, (*Storage)[Index]))
 		{
-			Array[Index] = Value;
+			GetMutableArray()[Index] = Forward<ValueType>(Value);
+			if(FAtkArrayChangeSet* Changes = GetBatchChanges())
+				Changes->RecordChange(Index);
+			EmitDelta(FAtkArrayDelta::Update(Index));
 			return true;
 		}
 		return false;
 	}
 
-	bool IsEmpty()
+	bool IsEmpty() const
 	{
-		return Array.IsEmpty();
+		return Storage->IsEmpty();
 	}
 
 	T& Last ()
 	{
-		return Array.Last();
+		return GetMutableArray().Last();
 	}
 	
 	bool ValidIndex(int32 Index) const
 	{
-		return Index >= 0 && Index < Array.Num();
+		return Index >= 0 && Index < Storage->Num();
 	}
 };
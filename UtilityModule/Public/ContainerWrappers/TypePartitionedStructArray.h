@@ -0,0 +1,184 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ContainerWrappers/StructBuffer.h"
+#include "TypePartitionedStructArray.generated.h"
+
+/**
+ * Location of an element inside a type partitioned array.
+ */
+USTRUCT(BlueprintType)
+struct UTILITYMODULE_API FAtkPartitionedIndex
+{
+	GENERATED_BODY()
+
+	FAtkPartitionedIndex() = default;
+	FAtkPartitionedIndex(int32 InBucket, int32 InIndex) : Bucket(InBucket), Index(InIndex) {}
+
+	UPROPERTY(BlueprintReadOnly, Category = "Struct Buffer")
+	int32 Bucket = INDEX_NONE;
+	UPROPERTY(BlueprintReadOnly, Category = "Struct Buffer")
+	int32 Index = INDEX_NONE;
+
+	bool IsValid() const { return Bucket != INDEX_NONE && Index != INDEX_NONE; }
+};
+
+/**
+ * Stable reference to an element of a type partitioned array, unlike its global index it does not move when other elements are
+ * removed. The slot of a removed element is reused with a new generation so handles to the removed element stop resolving.
+ */
+USTRUCT(BlueprintType)
+struct UTILITYMODULE_API FAtkPartitionedHandle
+{
+	GENERATED_BODY()
+
+	FAtkPartitionedHandle() = default;
+	FAtkPartitionedHandle(int32 InSlot, int32 InGeneration) : Slot(InSlot), Generation(InGeneration) {}
+
+	UPROPERTY(BlueprintReadOnly, Category = "Struct Buffer")
+	int32 Slot = INDEX_NONE;
+	UPROPERTY(BlueprintReadOnly, Category = "Struct Buffer")
+	int32 Generation = 0;
+
+	bool IsSet() const { return Slot != INDEX_NONE; }
+	bool operator==(const FAtkPartitionedHandle& Other) const { return Slot == Other.Slot && Generation == Other.Generation; }
+	bool operator!=(const FAtkPartitionedHandle& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Heterogeneous struct collection stored as one contiguous buffer per struct type.
+ * Elements keep a global index that follows insertion order, so they can still be visited in their original order,
+ * while type filtered passes run over dense memory without branching on the script struct of every element.
+ * Global indices shift on removal, keep an FAtkPartitionedHandle to refer to an element across removals.
+ */
+USTRUCT(BlueprintType)
+struct UTILITYMODULE_API FAtkTypePartitionedStructArray
+{
+	GENERATED_BODY()
+
+public:
+	// Adds a copy of Value in the bucket of its type, returns its global index
+	int32 Add(FConstStructView Value);
+	int32 Add(const FInstancedStruct& Value);
+	template <typename T>
+	int32 Add(const T& Value)
+	{
+		return Add(FConstStructView::Make(Value));
+	}
+	// Adds a default constructed element of StructType, returns its global index
+	int32 AddDefaulted(const UScriptStruct* StructType);
+	void Append(TConstArrayView<FInstancedStruct> Values);
+
+	// Removes an element and keeps the order of the others, global indices after it shift down by one
+	void RemoveAt(int32 GlobalIndex);
+	// Removes an element by moving the last global element in its place, does not keep order
+	void RemoveAtSwap(int32 GlobalIndex);
+	void Reset();
+	void Empty();
+
+	int32 Num() const { return Order.Num(); }
+	bool IsEmpty() const { return Order.IsEmpty(); }
+	bool IsValidIndex(int32 GlobalIndex) const { return Order.IsValidIndex(GlobalIndex); }
+	int32 NumTypes() const { return Buckets.Num(); }
+	TArray<const UScriptStruct*> GetTypes() const;
+
+	FStructView GetAt(int32 GlobalIndex);
+	FConstStructView GetAt(int32 GlobalIndex) const;
+	FAtkPartitionedIndex GetPartitionedIndex(int32 GlobalIndex) const { return Order[GlobalIndex]; }
+	int32 GetGlobalIndex(const FAtkPartitionedIndex& PartitionedIndex) const;
+
+	// Stable handle of the element currently at GlobalIndex
+	FAtkPartitionedHandle GetHandle(int32 GlobalIndex) const;
+	// False once the element of Handle was removed, or if Handle comes from another array
+	bool IsValidHandle(const FAtkPartitionedHandle& Handle) const { return GetGlobalIndex(Handle) != INDEX_NONE; }
+	// Current global index of the element of Handle, INDEX_NONE if it was removed
+	int32 GetGlobalIndex(const FAtkPartitionedHandle& Handle) const;
+	// Invalid view if the element of Handle was removed
+	FStructView Find(const FAtkPartitionedHandle& Handle);
+	FConstStructView Find(const FAtkPartitionedHandle& Handle) const;
+	void Remove(const FAtkPartitionedHandle& Handle);
+
+	// Every element of exactly StructType, nullptr when none was added
+	FAtkStructBuffer* FindBucket(const UScriptStruct* StructType);
+	const FAtkStructBuffer* FindBucket(const UScriptStruct* StructType) const;
+	TConstArrayView<FAtkStructBuffer> GetBuckets() const { return Buckets; }
+
+	// Calls Func on every element whose type is T or a child of T, bucket by bucket
+	template <typename T, typename FuncType>
+	void ForEachOfType(FuncType&& Func)
+	{
+		const UScriptStruct* Type = TBaseStructure<T>::Get();
+		for(FAtkStructBuffer& Bucket : Buckets)
+		{
+			if(!Bucket.GetScriptStruct()->IsChildOf(Type))
+				continue;
+			for(int32 i = 0; i < Bucket.Num(); ++i)
+			{
+				Func(Bucket.Get<T>(i));
+			}
+		}
+	}
+	template <typename T, typename FuncType>
+	void ForEachOfType(FuncType&& Func) const
+	{
+		const UScriptStruct* Type = TBaseStructure<T>::Get();
+		for(const FAtkStructBuffer& Bucket : Buckets)
+		{
+			if(!Bucket.GetScriptStruct()->IsChildOf(Type))
+				continue;
+			for(int32 i = 0; i < Bucket.Num(); ++i)
+			{
+				Func(Bucket.Get<T>(i));
+			}
+		}
+	}
+
+	// Calls Func with a view of every element in insertion order
+	template <typename FuncType>
+	void ForEachInOrder(FuncType&& Func)
+	{
+		for(const FAtkPartitionedIndex& Location : Order)
+		{
+			Func(Buckets[Location.Bucket].GetAt(Location.Index));
+		}
+	}
+	template <typename FuncType>
+	void ForEachInOrder(FuncType&& Func) const
+	{
+		for(const FAtkPartitionedIndex& Location : Order)
+		{
+			Func(Buckets[Location.Bucket].GetAt(Location.Index));
+		}
+	}
+
+	// Copies every element back in insertion order
+	TArray<FInstancedStruct> ToArray() const;
+
+private:
+	UPROPERTY()
+	TArray<FAtkStructBuffer> Buckets;
+
+	// Global index of every element of a bucket, parallel to the bucket memory
+	TArray<TArray<int32>> BucketGlobalIndices;
+	// Bucket and local index of every element in insertion order
+	TArray<FAtkPartitionedIndex> Order;
+	// Handle slot of every element, parallel to Order
+	TArray<int32> OrderSlots;
+	TMap<const UScriptStruct*, int32> BucketMap;
+
+	// Global index of the element owning each handle slot, INDEX_NONE for a free slot
+	TArray<int32> SlotGlobalIndices;
+	// Bumped every time a slot is released, survives Reset and Empty so older handles never resolve again
+	TArray<int32> SlotGenerations;
+	TArray<int32> FreeSlots;
+
+	int32 FindOrAddBucket(const UScriptStruct* StructType);
+	int32 AddToOrder(int32 Bucket, int32 LocalIndex);
+	// Points the element at GlobalIndex and its handle slot at each other after it moved in Order
+	void SetGlobalIndex(int32 GlobalIndex);
+	void ReleaseSlot(int32 Slot);
+	void ReleaseAllSlots();
+	// Removes an element from its bucket and patches the element that was moved into its slot
+	void RemoveFromBucket(const FAtkPartitionedIndex& Location);
+};
@@ -0,0 +1,73 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
+#else
+#include "InstancedStruct.h"
+#include "StructView.h"
+#endif
+#include "StructDumper.generated.h"
+
+UENUM(BlueprintType)
+enum class EAtkStructDumpFormat : uint8
+{
+	// One log entry per chunk of rows
+	Log,
+	// One header line per struct type followed by its rows
+	Csv,
+	// Array of objects, the struct type is written in the "_type" field
+	Json,
+};
+
+USTRUCT(BlueprintType)
+struct UTILITYMODULE_API FAtkStructDumpOptions
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Struct Dump")
+	EAtkStructDumpFormat Format = EAtkStructDumpFormat::Log;
+
+	// File written for Csv and Json, a file in the project log folder is used when empty
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Struct Dump")
+	FString FilePath;
+
+	// Names of the properties to dump, every property is dumped when empty
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Struct Dump")
+	TArray<FString> PropertyFilter;
+
+	// Maximum number of rows dumped, 0 for no limit
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Struct Dump", meta = (ClampMin = "0"))
+	int32 MaxRows = 0;
+
+	// Dumps one row out of SampleRate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Struct Dump", meta = (ClampMin = "1"))
+	int32 SampleRate = 1;
+};
+
+/**
+ * Formats structs into large text chunks and writes them to the log or to a file.
+ * Only the sampled rows are copied on the calling thread, formatting and writing happen on a worker thread.
+ * The async dumps export the properties that reference objects on the calling thread, call them from the game thread.
+ * Json writes infinite and NaN floating point values as null.
+ */
+class UTILITYMODULE_API FAtkStructDumper
+{
+public:
+	// Copies the sampled rows and dumps them on the thread pool, the future is true when every chunk was written
+	static TFuture<bool> DumpAsync(TConstArrayView<FInstancedStruct> Structs, const FAtkStructDumpOptions& Options);
+	static TFuture<bool> DumpAsync(TArray<FInstancedStruct>&& Structs, const FAtkStructDumpOptions& Options);
+	// Dumps the sampled rows on the calling thread
+	static bool Dump(TConstArrayView<FInstancedStruct> Structs, const FAtkStructDumpOptions& Options);
+
+	// "Type { Name: Value, ... }" for a single struct
+	static FString FormatStruct(FConstStructView Struct, TConstArrayView<FString> PropertyFilter = {});
+
+	// Indices of the rows kept by the sample rate and the row cap
+	static TArray<int32> GetSampledIndices(int32 Num, const FAtkStructDumpOptions& Options);
+	static FString GetOutputPath(const FAtkStructDumpOptions& Options);
+};
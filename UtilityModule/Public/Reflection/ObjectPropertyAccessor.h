@@ -0,0 +1,113 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * Bound reader for one object property of one class or struct.
+ * The property is found by name and its type is checked against the expected class once, then every read is an offset load.
+ * The binding is resolved again when the owner or expected class is reinstanced (hot reload, live coding, blueprint compile)
+ * or when a user defined struct owner is recompiled in place.
+ * Reads are meant for the game thread.
+ */
+class UTILITYMODULE_API FAtkObjectPropertyAccessor
+{
+public:
+	FAtkObjectPropertyAccessor() = default;
+	// Owner is the class or struct that declares the property, PropertyName can be the authored or the internal name
+	FAtkObjectPropertyAccessor(const UStruct* InOwner, FName InPropertyName, const UClass* InExpectedClass);
+
+	template <typename T>
+	static FAtkObjectPropertyAccessor Make(const UStruct* InOwner, FName InPropertyName)
+	{
+		return FAtkObjectPropertyAccessor(InOwner, InPropertyName, T::StaticClass());
+	}
+
+	// The property exists and holds objects of the expected class
+	bool IsValid() const;
+	const FObjectPropertyBase* GetProperty() const;
+
+	// Reads from raw container memory (a struct of the owner type, or an object)
+	UObject* Read(const void* Container) const;
+	// Reads from an object, returns nullptr when the object is not of the owner class
+	UObject* Read(const UObject* Object) const;
+	template <typename T>
+	T* Read(const UObject* Object) const
+	{
+		return Cast<T>(Read(Object));
+	}
+
+	// Reads the property of every object, entries are nullptr for objects that are null or not of the owner class
+	void ReadBatch(TConstArrayView<const UObject*> Objects, TArray<UObject*>& OutValues) const;
+	// Objects can be any indexable range of object pointers (TArray<AActor*>, TArrayView<TObjectPtr<UObject>>...)
+	template <typename T, typename RangeType>
+	void ReadBatch(const RangeType& Objects, TArray<T*>& OutValues) const
+	{
+		OutValues.Reset(Objects.Num());
+		ForEachValue(Objects.Num(), [&Objects](int32 Index) -> const UObject* { return Objects[Index]; }, [&OutValues](UObject* Value)
+		{
+			OutValues.Add(Cast<T>(Value));
+		});
+	}
+
+private:
+	mutable TWeakObjectPtr<const UStruct> Owner;
+	mutable TWeakObjectPtr<const UClass> ExpectedClass;
+	// Paths used to find the new types after reinstancing
+	FString OwnerPath;
+	FString ExpectedClassPath;
+	FName PropertyName;
+
+	mutable const FObjectPropertyBase* Property = nullptr;
+	mutable int32 Offset = INDEX_NONE;
+	// user defined structs keep their object when recompiled but get new properties
+	mutable const FProperty* OwnerPropertyLink = nullptr;
+	mutable int32 OwnerSize = 0;
+	mutable bool bCompatible = false;
+	mutable bool bResolved = false;
+
+	bool IsStale() const;
+	void Resolve() const;
+	void EnsureResolved() const
+	{
+		if (!bResolved || IsStale())
+		{
+			Resolve();
+		}
+	}
+
+	UObject* ReadUnchecked(const void* Container) const
+	{
+		return Property->GetObjectPropertyValue(static_cast<const uint8*>(Container) + Offset);
+	}
+
+	// The owner class check is only done again when the class changes from one object to the next
+	template <typename GetObjectType, typename FuncType>
+	void ForEachValue(int32 Num, GetObjectType&& GetObject, FuncType&& Func) const
+	{
+		EnsureResolved();
+		const UClass* OwnerClass = Cast<UClass>(Owner.Get());
+		const UClass* LastClass = nullptr;
+		bool bLastClassMatches = false;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			const UObject* Object = GetObject(Index);
+			if (!Object || !bCompatible || !OwnerClass)
+			{
+				Func(nullptr);
+				continue;
+			}
+			
+			const UClass* Class = Object->GetClass();
+			if (Class != LastClass)
+			{
+				LastClass = Class;
+				bLastClassMatches = Class->IsChildOf(OwnerClass);
+			}
+			Func(bLastClassMatches ? ReadUnchecked(Object) : nullptr);
+		}
+	}
+};
@@ -0,0 +1,103 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+
+/**
+ * Cached description of the memory layout of a UScriptStruct.
+ * Built once per struct type and shared, so copy, reset, compare and hash paths do not walk reflection data every call.
+ */
+class UTILITYMODULE_API FAtkStructLayout
+{
+public:
+	// Range of bytes covered by consecutive properties with no gaps between them
+	struct FMemoryRun
+	{
+		int32 Offset = 0;
+		int32 Size = 0;
+		// Index in GetProperties() of the first property of the run
+		int32 FirstProperty = 0;
+		int32 NumProperties = 0;
+	};
+
+	struct FPropertyLayout
+	{
+		const FProperty* Property = nullptr;
+		int32 Offset = 0;
+		int32 Size = 0;
+		// Index of the run in GetComparableRuns()/GetHashableRuns()/GetSerializableRuns(), INDEX_NONE when the property is not part of one
+		int32 ComparableRun = INDEX_NONE;
+		int32 HashableRun = INDEX_NONE;
+		int32 SerializableRun = INDEX_NONE;
+	};
+
+	// Returns the layout of the struct, built on first use. Safe to call from any thread
+	static TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Get(const UScriptStruct* Struct);
+	// Drops every cached layout, called when classes and structs are reloaded
+	static void ClearCache();
+
+	// Value can be copied with memcpy (plain old data, no bitfields)
+	static bool IsMemoryCopyable(const FProperty* Property);
+	// Value can also be compared with memcmp (no floating point, no padding)
+	static bool IsMemoryComparable(const FProperty* Property);
+	// Bytes mean the same in another process (numbers, enums and native bools)
+	static bool IsMemorySerializable(const FProperty* Property);
+	// Serializable and equal values have equal bytes (no floating point)
+	static bool IsMemoryHashable(const FProperty* Property);
+
+	const UScriptStruct* GetStruct() const { return Struct; }
+	int32 GetSize() const { return Size; }
+	int32 GetAlignment() const { return Alignment; }
+	
+	// Can be copied and compared with memcpy/memcmp
+	bool IsPlainOldData() const { return bPlainOldData; }
+	// Default state is all zeros
+	bool IsZeroConstructible() const { return bZeroConstructible; }
+	// Nothing to do when destroyed
+	bool HasNoDestructor() const { return bNoDestructor; }
+	
+	// Stable hash of the struct name, used to seed content hashes
+	uint64 GetTypeSeed() const { return TypeSeed; }
+
+	// Properties in PropertyLink order
+	TConstArrayView<FPropertyLayout> GetProperties() const { return Properties; }
+	// Parent struct properties first, then child properties, with the ID property at the beginning
+	TConstArrayView<const FProperty*> GetOrderedProperties() const { return OrderedProperties; }
+	// Runs of properties whose bytes fully describe their value (plain old data, no bitfields, no floating point)
+	TConstArrayView<FMemoryRun> GetComparableRuns() const { return ComparableRuns; }
+	// Runs of properties whose bytes are the same across program runs for equal values (no names, pointers or floating point)
+	TConstArrayView<FMemoryRun> GetHashableRuns() const { return HashableRuns; }
+	// Runs of properties that can be written and read back as raw bytes (no names or pointers)
+	TConstArrayView<FMemoryRun> GetSerializableRuns() const { return SerializableRuns; }
+
+	// Constructs a default struct in uninitialized memory
+	void InitializeStruct(void* Dest, int32 Count = 1) const;
+	void DestroyStruct(void* Dest, int32 Count = 1) const;
+	void CopyStruct(void* Dest, const void* Src, int32 Count = 1) const;
+	// Puts an initialized struct back into its default state
+	void ResetStruct(void* Dest) const;
+	bool CompareStruct(const void* A, const void* B) const;
+
+	explicit FAtkStructLayout(const UScriptStruct* InStruct);
+
+private:
+	const UScriptStruct* Struct = nullptr;
+	const FProperty* FirstProperty = nullptr;
+	int32 Size = 0;
+	int32 Alignment = 1;
+	bool bPlainOldData = false;
+	bool bZeroConstructible = false;
+	bool bNoDestructor = false;
+	// every property is covered by a comparable run
+	bool bFullyComparable = false;
+	uint64 TypeSeed = 0;
+	
+	TArray<FPropertyLayout> Properties;
+	TArray<const FProperty*> OrderedProperties;
+	TArray<FMemoryRun> ComparableRuns;
+	TArray<FMemoryRun> HashableRuns;
+	TArray<FMemoryRun> SerializableRuns;
+
+	bool IsUpToDate() const;
+};
@@ -0,0 +1,103 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#else
+#include "InstancedStruct.h"
+#endif
+
+class FAtkStructLayout;
+
+/**
+ * Converts structs of one type into another type, memory to memory.
+ *
+ * The field mapping is compiled once: every target property is matched to a source property by name (or by an explicit rename)
+ * and gets the cheapest conversion that fits, a raw copy for identical plain old data, a property copy for identical types,
+ * a numeric cast between numbers, a custom converter, or a text round trip for everything else.
+ * Target properties without a source keep the target default, which can be overridden with SetDefault.
+ *
+ *	FAtkStructMigration Migration(FItemV1::StaticStruct(), FItemV2::StaticStruct());
+ *	Migration.Rename(TEXT("Tag"), TEXT("Category")).SetDefault(TEXT("Stack"), TEXT("1"));
+ *	Migration.MigrateArray(Items);
+ */
+class UTILITYMODULE_API FAtkStructMigration
+{
+public:
+	// Writes the value of a source property into a target property, called from worker threads by MigrateArray
+	using FConverter = TFunction<bool(const FProperty* SourceProperty, const void* SourceValue, const FProperty* TargetProperty, void* TargetValue)>;
+
+	FAtkStructMigration(const UScriptStruct* InSource, const UScriptStruct* InTarget);
+
+	// Mapping setup, must happen before the first migration
+	FAtkStructMigration& Rename(FName SourceName, FName TargetName);
+	FAtkStructMigration& Convert(FName SourceName, FName TargetName, FConverter Converter);
+	// Value of a target property when no source property maps to it, in the text format of the property
+	FAtkStructMigration& SetDefault(FName TargetName, const FString& ValueText);
+
+	// Builds the field mapping, called by the first migration when not called before
+	void Compile();
+	bool IsCompiled() const { return bCompiled; }
+	// Target properties that only receive their default
+	TArray<FName> GetUnmappedTargetProperties() const;
+
+	const UScriptStruct* GetSourceStruct() const { return Source; }
+	const UScriptStruct* GetTargetStruct() const { return Target; }
+
+	// Fills an initialized target struct from a source struct, returns false if a field failed to convert
+	bool MigrateStruct(const void* SourceData, void* TargetData);
+	bool Migrate(const FInstancedStruct& SourceStruct, FInstancedStruct& OutTarget);
+	// Converts every struct of the source type in place, in parallel, other structs are left untouched
+	// returns the number of structs converted. Runs on the calling thread when a text conversion can look up or load objects
+	// (object, class and soft references), call it from the game thread then
+	int32 MigrateArray(TArray<FInstancedStruct>& Structs, int32 GrainSize = 1024);
+
+private:
+	enum class EFieldOp : uint8
+	{
+		// memcpy of Size bytes, consecutive raw copies are merged
+		Raw,
+		// same property type, CopyCompleteValue
+		Copy,
+		// number to number
+		Numeric,
+		Custom,
+		// export to text then import into the target
+		Text,
+	};
+
+	struct FField
+	{
+		EFieldOp Op = EFieldOp::Raw;
+		const FProperty* SourceProperty = nullptr;
+		const FProperty* TargetProperty = nullptr;
+		int32 SourceOffset = 0;
+		int32 TargetOffset = 0;
+		int32 Size = 0;
+		int32 Converter = INDEX_NONE;
+	};
+
+	const UScriptStruct* Source = nullptr;
+	const UScriptStruct* Target = nullptr;
+	TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> TargetLayout;
+
+	// target name -> source name
+	TMap<FName, FName> Renames;
+	TMap<FName, int32> ConverterIndices;
+	TArray<FConverter> Converters;
+	TMap<FName, FString> Defaults;
+
+	// Target default with the SetDefault values applied, copied into every new target
+	FInstancedStruct TargetDefault;
+	TArray<FField> Fields;
+	TArray<FName> UnmappedTargetProperties;
+	bool bCompiled = false;
+	// a text field imports object references, which finds or loads objects and must stay on the game thread
+	bool bTextReferencesObjects = false;
+
+	bool ApplyFields(const uint8* SourceData, uint8* TargetData) const;
+	static EFieldOp GetFieldOp(const FProperty* SourceProperty, const FProperty* TargetProperty);
+	static bool ReferencesObjects(const FProperty* Property, TSet<const UStruct*>& VisitedStructs);
+};
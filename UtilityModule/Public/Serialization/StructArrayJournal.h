@@ -0,0 +1,93 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#else
+#include "InstancedStruct.h"
+#endif
+#include "Tasks/Task.h"
+
+/**
+ * Append-only journal of the edits made to an array of instanced structs, persisted next to a snapshot of the array.
+ *
+ * BasePath.snapshot holds the whole array and BasePath.journal the edits made since. Both files are a header (magic, version,
+ * generation) followed by records: payload size, payload CRC and payload. Structs are written with FAtkStructRowFormat and a
+ * changed struct only writes the properties that differ.
+ * Edits and snapshots are encoded on the calling thread, which resolves object references, and written by a background task.
+ * Compact writes a fresh snapshot in the background then restarts the journal with the snapshot generation, a journal is only replayed over the snapshot of its generation so a
+ * crash in between never applies edits twice. A record torn by a crash fails its CRC and ends the replay.
+ * Files are flushed to the OS after every write, not synced to the disk.
+ */
+class UTILITYMODULE_API FAtkStructArrayJournal
+{
+public:
+	using FArraySnapshot = TSharedRef<const TArray<FInstancedStruct>, ESPMode::ThreadSafe>;
+
+	/**
+	 * Reads the snapshot and replays the journal over it.
+	 * @return false if the snapshot cannot be read or holds structs whose type is missing or whose layout changed, OutStructs is
+	 * empty then and the files must not be replaced. Nothing saved yet is an empty array.
+	 */
+	static bool Load(const FString& BasePath, TArray<FInstancedStruct>& OutStructs);
+
+	// Structs become the snapshot of a new generation, replacing what is saved at BasePath, and the journal starts empty
+	FAtkStructArrayJournal(const FString& InBasePath, FArraySnapshot Structs);
+	// Waits for the pending writes
+	~FAtkStructArrayJournal();
+	UE_NONCOPYABLE(FAtkStructArrayJournal);
+
+	void AppendInsert(int32 Index, TConstArrayView<FInstancedStruct> Structs);
+	void AppendRemove(int32 Index, int32 Count);
+	void AppendSwap(int32 FirstIndex, int32 SecondIndex);
+	void AppendSet(int32 Index, const FInstancedStruct& OldStruct, const FInstancedStruct& NewStruct);
+
+	// Replaces the snapshot with Structs and empties the journal, the edits not written yet are dropped as Structs holds them.
+	// Structs are encoded before returning, call it from the game thread when they reference objects
+	void Compact(FArraySnapshot Structs);
+
+	// Blocks until everything appended so far is on disk
+	void Flush();
+
+	// Bytes appended since the last compaction
+	int64 GetJournalSize() const { return JournalSize; }
+	const FString& GetBasePath() const { return BasePath; }
+
+	static FString GetSnapshotPath(const FString& BasePath) { return BasePath + TEXT(".snapshot"); }
+	static FString GetJournalPath(const FString& BasePath) { return BasePath + TEXT(".journal"); }
+
+private:
+	class FEncoder;
+
+	// The encoded snapshot of a compaction, written before Bytes
+	struct FPendingWrite
+	{
+		bool bSnapshot = false;
+		TArray<uint8> SnapshotBytes;
+		uint32 Generation = 0;
+		TArray<uint8> Bytes;
+	};
+
+	// Hands the records encoded by Encoder to the writer task
+	void Submit();
+	// Launches the writer task if it is not running, PendingLock must be held
+	void StartWriter();
+	// Writer task, runs until no write is pending
+	void WritePending();
+	void WriteSnapshot(const TArray<uint8>& SnapshotBytes, uint32 SnapshotGeneration);
+
+	FString BasePath;
+	TUniquePtr<FEncoder> Encoder;
+	uint32 Generation = 0;
+	int64 JournalSize = 0;
+
+	FCriticalSection PendingLock;
+	FPendingWrite Pending;
+	UE::Tasks::FTask WriterTask;
+	bool bWriterRunning = false;
+
+	// only used by the writer task
+	TUniquePtr<FArchive> JournalWriter;
+};
@@ -0,0 +1,103 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
+#else
+#include "InstancedStruct.h"
+#include "StructView.h"
+#endif
+
+class FAtkStructLayout;
+
+/**
+ * Flat binary format for rows of reflected structs.
+ *
+ * Stream: magic, version, then records. A schema record (struct path + layout hash) is written the first time a struct type
+ * is seen, a row record is the schema index, the payload size and the payload. Payloads are written from the struct layout:
+ * runs of numbers, enums and native bools are copied as raw bytes, strings are length prefixed and every other property,
+ * names and objects included, goes through its own SerializeItem with names and objects written as strings.
+ * Raw bytes are in native endianness, the format is meant for tools and snapshots on the same platform.
+ */
+struct UTILITYMODULE_API FAtkStructRowFormat
+{
+	static constexpr uint32 Magic = 0x524B5441; // "ATKR"
+	static constexpr uint16 Version = 2;
+	// Largest payload a reader accepts when the stream does not know its size
+	static constexpr int32 MaxPayloadSize = 64 * 1024 * 1024;
+
+	enum class ERecord : uint8
+	{
+		Schema,
+		Row,
+		End,
+	};
+
+	// Hash of every property name, type, offset and size the payload depends on, rows are rejected when it does not match
+	static uint64 GetLayoutHash(const UScriptStruct* Struct);
+	// Reads or writes the payload of one struct, Data must be an initialized struct of the layout type
+	static void SerializePayload(FArchive& Ar, FArchive& ProxyAr, const FAtkStructLayout& Layout, uint8* Data);
+	// Reads or writes a single property the way SerializePayload writes it when it is not part of a raw run
+	static void SerializeProperty(FArchive& Ar, FArchive& ProxyAr, const FProperty* Property, uint8* ValuePtr);
+};
+
+/**
+ * Writes rows to an archive one at a time, so large arrays can be streamed to a file or socket.
+ */
+class UTILITYMODULE_API FAtkStructRowWriter
+{
+public:
+	// Writes the stream header
+	explicit FAtkStructRowWriter(FArchive& InArchive);
+	// Writes the end record if Finish was not called
+	~FAtkStructRowWriter();
+
+	bool Write(FConstStructView Row);
+	bool Write(const FInstancedStruct& Row);
+	int32 WriteAll(TConstArrayView<FInstancedStruct> Rows);
+	// Ends the stream, no row can be written after
+	void Finish();
+
+	int32 NumRows() const { return RowCount; }
+	bool IsError() const { return Archive.IsError(); }
+
+private:
+	FArchive& Archive;
+	TMap<const UScriptStruct*, int32> Schemas;
+	// Row payloads are written here first so their size can be written in front of them
+	TArray<uint8> Scratch;
+	int32 RowCount = 0;
+	bool bFinished = false;
+};
+
+/**
+ * Reads rows written by FAtkStructRowWriter, one at a time.
+ */
+class UTILITYMODULE_API FAtkStructRowReader
+{
+public:
+	// Reads and validates the stream header
+	explicit FAtkStructRowReader(FArchive& InArchive);
+
+	bool IsValid() const { return bValid; }
+	// Reads the next row whose schema matches the current struct layout, returns false at the end of the stream or on error
+	bool Read(FInstancedStruct& OutRow);
+	TArray<FInstancedStruct> ReadAll();
+
+private:
+	struct FSchema
+	{
+		const UScriptStruct* Struct = nullptr;
+		bool bMatches = false;
+	};
+	
+	FArchive& Archive;
+	TArray<FSchema> Schemas;
+	TArray<uint8> Scratch;
+	bool bValid = false;
+
+	bool ReadSchema();
+};
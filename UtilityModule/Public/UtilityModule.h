@@ -14,5 +14,7 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
-	
+
+private:
+	FDelegateHandle ReloadCompleteHandle;
 };
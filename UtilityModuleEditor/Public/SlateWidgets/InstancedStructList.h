@@ -19,6 +19,8 @@
 #include "InstancedStruct.h"
 #endif
 #include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
+#include "Reflection/StructLayout.h"
+#include "HAL/PlatformApplicationMisc.h"
 
 DECLARE_DELEGATE_TwoParams(FPropertyEditedSignature, const FName &, const FText &);
 // Custom Editable text with an identifier so that we know which property was changed
@@ -184,14 +186,19 @@ public:
         {
             for (const auto &Struct : *InArgs._StructTypes)
             {
-                TArray<const FProperty *> OrderedProperties = UAtkStructUtilsFunctionLibrary::GetOrderedProperties(Struct);
-                for (const FProperty *Property : OrderedProperties)
+                const TSharedPtr<const FAtkStructLayout, ESPMode::ThreadSafe> Layout = FAtkStructLayout::Get(Struct);
+                if (!Layout)
+                {
+                    continue;
+                }
+                for (const FProperty *Property : Layout->GetOrderedProperties())
                 {
                     const FText PropertyNameText = Property->GetDisplayNameText();
                     const FName PropertyName(PropertyNameText.ToString());
                     if (!HeaderRow->IsColumnVisible(PropertyName))
                     {
                         HeaderRow->AddColumn(SHeaderRow::Column(PropertyName).DefaultLabel(PropertyNameText).ManualWidth(100.0f));
+                        ColumnPropertyNames.Add(Property->GetAuthoredName());
                     }
                 }
             }
@@ -254,6 +261,101 @@ public:
         }
     }
 
+    virtual FReply OnKeyDown(const FGeometry &MyGeometry, const FKeyEvent &InKeyEvent) override
+    {
+        if (InKeyEvent.IsControlDown() && InKeyEvent.GetKey() == EKeys::V)
+        {
+            FString ClipboardText;
+            FPlatformApplicationMisc::ClipboardPaste(ClipboardText);
+            if (PasteRows(ClipboardText) > 0)
+            {
+                return FReply::Handled();
+            }
+        }
+        return SCompoundWidget::OnKeyDown(MyGeometry, InKeyEvent);
+    }
+
+    /**
+     * Paste tab separated rows (as copied from a spreadsheet) into the list.
+     * Rows are applied from the first selected item onwards, columns from FirstColumn onwards.
+     * Returns the number of values that were applied.
+     */
+    virtual int32 PasteRows(const FString &Text, int32 FirstColumn = 0)
+    {
+        if (!List || !ListView.IsValid())
+        {
+            return 0;
+        }
+
+        TArray<FString> Lines;
+        Text.ParseIntoArrayLines(Lines, false);
+        while (Lines.Num() > 0 && Lines.Last().IsEmpty())
+        {
+            Lines.Pop();
+        }
+
+        // paste starts at the first selected item in list order
+        int32 FirstRow = 0;
+        const TArray<TSharedPtr<FInstancedStruct>> Selected = ListView->GetSelectedItems();
+        if (Selected.Num() > 0)
+        {
+            FirstRow = List->Num();
+            for (const TSharedPtr<FInstancedStruct> &Item : Selected)
+            {
+                FirstRow = FMath::Min(FirstRow, List->IndexOfByKey(Item));
+            }
+        }
+
+        const int32 NumRows = FMath::Min(Lines.Num(), List->Num() - FirstRow);
+        if (NumRows <= 0)
+        {
+            return 0;
+        }
+
+        TArray<FInstancedStruct *> Rows;
+        TArray<TArray<FString>> Cells;
+        Rows.Reserve(NumRows);
+        Cells.Reserve(NumRows);
+        for (int32 Row = 0; Row < NumRows; ++Row)
+        {
+            Rows.Add((*List)[FirstRow + Row].Get());
+            Lines[Row].ParseIntoArray(Cells.AddDefaulted_GetRef(), TEXT("\t"), false);
+        }
+
+        // apply column by column so each property is resolved once per struct type
+        int32 Applied = 0;
+        TArray<FString> ColumnValues;
+        for (int32 Column = FirstColumn; Column < ColumnPropertyNames.Num(); ++Column)
+        {
+            const int32 CellIndex = Column - FirstColumn;
+            TArray<FInstancedStruct *> ColumnRows;
+            ColumnValues.Reset();
+            for (int32 Row = 0; Row < NumRows; ++Row)
+            {
+                if (Cells[Row].IsValidIndex(CellIndex))
+                {
+                    ColumnRows.Add(Rows[Row]);
+                    ColumnValues.Add(Cells[Row][CellIndex]);
+                }
+            }
+            if (ColumnRows.IsEmpty())
+            {
+                break;
+            }
+            Applied += UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructsFromString(ColumnRows, ColumnPropertyNames[Column], ColumnValues);
+        }
+
+        if (Applied > 0)
+        {
+            for (const FInstancedStruct *Row : Rows)
+            {
+                ItemUpdateDelegate.ExecuteIfBound(*Row);
+            }
+            RefreshList();
+        }
+        return Applied;
+    }
+
     virtual void SetSelection(const TArray<int32>& Indexes)
     {
         // used only for map plugin maybe adapt
@@ -283,5 +385,7 @@ protected:
     TArray<TSharedPtr<FInstancedStruct>>* List;
     TSharedPtr<SListView<TSharedPtr<FInstancedStruct>>> ListView;
     TSharedPtr<SHeaderRow> HeaderRow;
+    // authored property name of each header column, in column order
+    TArray<FString> ColumnPropertyNames;
     FItemChangedSignature ItemUpdateDelegate;
 };
@@ -49,6 +49,7 @@ public class UtilityModuleEditor : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"ApplicationCore",
 				"Slate",
 				"SlateCore",
 				"CoreUObject",
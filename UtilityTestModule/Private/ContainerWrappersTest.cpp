@@ -0,0 +1,482 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Async/ParallelFor.h"
+#include "ContainerWrappers/ManagerObjectsArray.h"
+#include "ContainerWrappers/ManagerStructsArray.h"
+#include "ContainerWrappers/ManagerStableStructsArray.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    struct FRecordingDeltaListener : public IAtkArrayDeltaListener
+    {
+        TArray<FAtkArrayDelta> Deltas;
+        virtual void OnArrayDelta(const FAtkArrayDelta& Delta) override { Deltas.Add(Delta); }
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContainerWrappersChangeSetTest, "AnastacioUtilityToolkit.UtilityModule.ContainerWrappers.ChangeSet", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FContainerWrappersChangeSetTest::RunTest(const FString& Parameters)
+{
+    // Test indices follow inserts and removes made later in the batch
+    {
+        FAtkArrayChangeSet Changes;
+        Changes.RecordChange(2);
+        Changes.RecordInsert(10, 3);
+        Changes.RecordInsert(0);
+        Changes.RecordRemove(11);
+        Changes.RecordRemove(1);
+        Changes.Finalize();
+        TestEqual("Added indices", Changes.AddedIndices, TArray<int32>({ 0, 10, 11 }));
+        TestEqual("Changed indices", Changes.ChangedIndices, TArray<int32>({ 2 }));
+        TestEqual("Removed indices before the batch", Changes.RemovedIndices, TArray<int32>({ 0 }));
+    }
+
+    // Test removed indices are reported as they were before the batch
+    {
+        FAtkArrayChangeSet Changes;
+        Changes.RecordRemove(1);
+        Changes.RecordRemove(1);
+        Changes.RecordInsert(0, 2);
+        Changes.RecordRemove(3);
+        Changes.RecordRemove(0);
+        Changes.Finalize();
+        TestEqual("Removed indices", Changes.RemovedIndices, TArray<int32>({ 1, 2, 3 }));
+        TestEqual("Added indices", Changes.AddedIndices, TArray<int32>({ 0 }));
+    }
+
+    // Test elements past the touched ones keep their original indices
+    {
+        FAtkArrayChangeSet Changes;
+        Changes.RecordRemove(0);
+        Changes.RecordChange(5);
+        Changes.RecordRemove(7);
+        Changes.RecordChange(5);
+        Changes.RecordInsert(2);
+        Changes.RecordRemove(2);
+        TestTrue("Repeated changes are not empty", !Changes.IsEmpty());
+        Changes.Finalize();
+        TestEqual("Changed once", Changes.ChangedIndices, TArray<int32>({ 5 }));
+        TestEqual("Removed untouched elements", Changes.RemovedIndices, TArray<int32>({ 0, 8 }));
+        TestTrue("Added and removed in the batch", Changes.AddedIndices.IsEmpty());
+    }
+
+    // Test a reset replaces everything recorded before
+    {
+        FAtkArrayChangeSet Changes;
+        Changes.RecordInsert(0, 5);
+        Changes.RecordReset();
+        Changes.RecordInsert(0);
+        TestTrue("Reset", Changes.bReset);
+        TestTrue("No indices after a reset", Changes.AddedIndices.IsEmpty());
+    }
+
+    // Test the manager holds back item events inside a batch
+    {
+        UTkManagerObjectsArray* Manager = NewObject<UTkManagerObjectsArray>();
+        {
+            TAtkArrayBatchScope Batch(*Manager);
+            Manager->Add_BP(Manager);
+            Manager->Add_BP(Manager);
+            TestTrue("In batch", Manager->IsInBatch());
+        }
+        TestFalse("Batch ended", Manager->IsInBatch());
+        TestEqual("Elements added", Manager->Num(), 2);
+    }
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContainerWrappersDeltaTest, "AnastacioUtilityToolkit.UtilityModule.ContainerWrappers.Delta", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FContainerWrappersDeltaTest::RunTest(const FString& Parameters)
+{
+    UTkManagerObjectsArray* Manager = NewObject<UTkManagerObjectsArray>();
+    FRecordingDeltaListener Listener;
+    Manager->AddDeltaListener(&Listener);
+
+    Manager->Add_BP(Manager);
+    Manager->AddMultiple_BP({ Manager, Manager, Manager });
+    Manager->Swap_BP(0, 3);
+    Manager->Remove_BP(Manager);
+    {
+        TAtkArrayBatchScope Batch(*Manager);
+        Manager->Clear_BP();
+    }
+    Manager->RemoveDeltaListener(&Listener);
+    Manager->Add_BP(Manager);
+
+    if(TestEqual("Deltas", Listener.Deltas.Num(), 5))
+    {
+        TestTrue("Add", Listener.Deltas[0].Type == EAtkArrayDeltaType::Insert && Listener.Deltas[0].Index == 0 && Listener.Deltas[0].Count == 1);
+        TestTrue("AddMultiple is one range", Listener.Deltas[1].Type == EAtkArrayDeltaType::Insert && Listener.Deltas[1].Index == 1 && Listener.Deltas[1].Count == 3);
+        TestTrue("Swap", Listener.Deltas[2].Type == EAtkArrayDeltaType::Move && Listener.Deltas[2].Index == 0 && Listener.Deltas[2].OtherIndex == 3);
+        TestTrue("Remove", Listener.Deltas[3].Type == EAtkArrayDeltaType::Remove && Listener.Deltas[3].Index == 0);
+        TestTrue("Native listeners see batched changes", Listener.Deltas[4].Type == EAtkArrayDeltaType::Reset);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContainerWrappersMoveTest, "AnastacioUtilityToolkit.UtilityModule.ContainerWrappers.Move", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FContainerWrappersMoveTest::RunTest(const FString& Parameters)
+{
+    UTkManagerStructsArray* Manager = NewObject<UTkManagerStructsArray>();
+
+    // Test an empty manager takes the allocation of the moved array
+    TArray<FInstancedStruct> Loaded;
+    Loaded.Add(FInstancedStruct::Make(FVector(1.0)));
+    Loaded.Add(FInstancedStruct::Make(FVector(2.0)));
+    const FInstancedStruct* LoadedData = Loaded.GetData();
+    Manager->AddMultiple(MoveTemp(Loaded));
+    TestTrue("Allocation moved", Manager->GetView().GetData() == LoadedData);
+    TestTrue("Source emptied", Loaded.IsEmpty());
+
+    // Test the struct memory of a moved instanced struct is kept
+    FInstancedStruct Single = FInstancedStruct::Make(FVector(3.0));
+    const uint8* SingleMemory = Single.GetMemory();
+    Manager->Add(MoveTemp(Single));
+    TestTrue("Struct memory moved", Manager->GetView().Last().GetMemory() == SingleMemory);
+
+    Manager->Emplace<FVector>(4.0, 5.0, 6.0);
+    TestEqual("Emplaced", Manager->GetView().Last().Get<FVector>(), FVector(4.0, 5.0, 6.0));
+    TestEqual("Elements", Manager->Num(), 4);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContainerWrappersBulkRemoveTest, "AnastacioUtilityToolkit.UtilityModule.ContainerWrappers.BulkRemove", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FContainerWrappersBulkRemoveTest::RunTest(const FString& Parameters)
+{
+    UTkManagerStructsArray* Manager = NewObject<UTkManagerStructsArray>();
+    for(int32 i = 0; i < 8; ++i)
+    {
+        Manager->Emplace<FVector>(static_cast<double>(i % 2), static_cast<double>(i), 0.0);
+    }
+    FRecordingDeltaListener Listener;
+    Manager->AddDeltaListener(&Listener);
+
+    // Test every odd X is removed in one pass, keeping the order of the rest
+    const int32 NumRemoved = Manager->RemoveByPropertyValue_BP(TEXT("X"), TEXT("1.000000"));
+    TestEqual("Removed by value", NumRemoved, 4);
+    if(TestEqual("Remaining", Manager->Num(), 4))
+    {
+        TestEqual("Order kept", Manager->GetView()[3].Get<FVector>().Y, 6.0);
+    }
+    TestEqual("One delta per removed run", Listener.Deltas.Num(), 4);
+
+    // Test duplicated and invalid indices are skipped
+    TestEqual("Removed at indices", Manager->RemoveAtIndices_BP({ 2, 0, 2, 10, -1 }), 2);
+    TestEqual("Y of first", Manager->GetView()[0].Get<FVector>().Y, 2.0);
+
+    TestTrue("Remove at swap", Manager->RemoveAtSwap_BP(0));
+    TestEqual("Last moved in", Manager->GetView()[0].Get<FVector>().Y, 6.0);
+    TestEqual("Cached hashes follow", Manager->FindIndex(FInstancedStruct::Make(FVector(0.0, 6.0, 0.0))), 0);
+
+    // Test a bulk removal only notifies the Blueprint events once
+    UTkManagerStructsArray* Bound = NewObject<UTkManagerStructsArray>();
+    for(int32 i = 0; i < 8; ++i)
+    {
+        Bound->Emplace<FVector>(static_cast<double>(i), 0.0, 0.0);
+    }
+    UAtkTestArrayEventRecorder* Recorder = NewObject<UAtkTestArrayEventRecorder>();
+    Bound->OnArrayDelta.AddDynamic(Recorder, &UAtkTestArrayEventRecorder::OnArrayDelta);
+    Bound->OnStructRemoved.AddDynamic(Recorder, &UAtkTestArrayEventRecorder::OnStructRemoved);
+    Bound->OnBatchCommitted.AddDynamic(Recorder, &UAtkTestArrayEventRecorder::OnBatchCommitted);
+    Bound->RemoveAtIndices_BP({ 1, 2, 4 });
+    TestTrue("No Blueprint deltas", Recorder->Deltas.IsEmpty());
+    TestTrue("No removed events", Recorder->RemovedStructs.IsEmpty());
+    if(TestEqual("One batch", Recorder->Batches.Num(), 1))
+    {
+        TestEqual("Batch removed indices", Recorder->Batches[0].RemovedIndices, TArray<int32>({ 1, 2, 4 }));
+    }
+
+    // Test the per item events fire when asked for
+    Recorder->Batches.Reset();
+    Bound->RemoveAtIndices_BP({ 0, 3, 4 }, true);
+    if(TestEqual("Blueprint deltas", Recorder->Deltas.Num(), 2))
+    {
+        TestEqual("Last run first", Recorder->Deltas[0].Index, 3);
+        TestEqual("Last run count", Recorder->Deltas[0].Count, 2);
+        TestEqual("First run", Recorder->Deltas[1].Index, 0);
+    }
+    TestEqual("Removed events", Recorder->RemovedStructs.Num(), 3);
+    TestEqual("Still one batch", Recorder->Batches.Num(), 1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContainerWrappersStableTest, "AnastacioUtilityToolkit.UtilityModule.ContainerWrappers.Stable", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FContainerWrappersStableTest::RunTest(const FString& Parameters)
+{
+    UTkManagerStableStructsArray* Manager = NewObject<UTkManagerStableStructsArray>();
+    const FAtkStructHandle First = Manager->Emplace<FVector>(1.0, 0.0, 0.0);
+    const FInstancedStruct* FirstPtr = Manager->Find(First);
+
+    // Test the address of a struct does not change while more chunks are added
+    TArray<FAtkStructHandle> Handles;
+    for(int32 i = 0; i < 1000; ++i)
+    {
+        Handles.Add(Manager->Emplace<FVector>(static_cast<double>(i), 1.0, 0.0));
+    }
+    TestTrue("Stable address", Manager->Find(First) == FirstPtr);
+
+    // Test a removed handle stays invalid after its slot is reused
+    TestTrue("Removed", Manager->Remove_BP(Handles[10]));
+    const FAtkStructHandle Reused = Manager->InsertBefore_BP(First, FInstancedStruct::Make(FVector(-1.0)));
+    TestEqual("Slot reused", Reused.Slot, Handles[10].Slot);
+    TestFalse("Stale handle", Manager->IsValidHandle(Handles[10]));
+    TestNull("Stale handle finds nothing", Manager->Find(Handles[10]));
+
+    // Test the order follows the inserts
+    const TArray<FAtkStructHandle> Ordered = Manager->GetHandles_BP();
+    if(TestEqual("Num", Ordered.Num(), 1001))
+    {
+        TestTrue("Inserted first", Ordered[0] == Reused);
+        TestTrue("Then the first added", Ordered[1] == First);
+    }
+
+    Manager->Clear_BP();
+    TestFalse("Cleared handle", Manager->IsValidHandle(First));
+    TestEqual("Empty", Manager->Num(), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContainerWrappersQueueTest, "AnastacioUtilityToolkit.UtilityModule.ContainerWrappers.Queue", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FContainerWrappersQueueTest::RunTest(const FString& Parameters)
+{
+    UTkManagerStructsArray* Manager = NewObject<UTkManagerStructsArray>();
+    FRecordingDeltaListener Listener;
+    Manager->AddDeltaListener(&Listener);
+
+    // Test edits queued from worker threads are all applied once flushed
+    ParallelFor(256, [Manager](int32 Index)
+    {
+        Manager->EnqueueAdd(FInstancedStruct::Make(FVector(static_cast<double>(Index))));
+    });
+    TestEqual("Nothing applied before the drain", Manager->Num(), 0);
+    Manager->FlushQueue();
+    TestEqual("Applied", Manager->Num(), 256);
+    TestEqual("One delta per edit", Listener.Deltas.Num(), 256);
+
+    // Test the edits of one producer keep their order
+    Manager->EnqueueClear();
+    Manager->EnqueueAdd(FInstancedStruct::Make(FVector(1.0)));
+    Manager->EnqueueSetAt(0, FInstancedStruct::Make(FVector(2.0)));
+    Manager->FlushQueue();
+    if(TestEqual("Cleared then added", Manager->Num(), 1))
+    {
+        TestEqual("Set after add", Manager->GetView()[0].Get<FVector>(), FVector(2.0));
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContainerWrappersSnapshotTest, "AnastacioUtilityToolkit.UtilityModule.ContainerWrappers.Snapshot", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FContainerWrappersSnapshotTest::RunTest(const FString& Parameters)
+{
+    UTkManagerStructsArray* Manager = NewObject<UTkManagerStructsArray>();
+    for(int32 i = 0; i < 64; ++i)
+    {
+        Manager->Emplace<FVector>(static_cast<double>(i));
+    }
+
+    // Test the snapshot shares the storage until the next edit
+    const TSharedRef<const TArray<FInstancedStruct>, ESPMode::ThreadSafe> Snapshot = Manager->GetSnapshot();
+    TestTrue("Shared storage", Snapshot->GetData() == Manager->GetView().GetData());
+
+    Manager->SetAt(0, FInstancedStruct::Make(FVector(-1.0)));
+    Manager->Clear_BP();
+    TestEqual("Manager cleared", Manager->Num(), 0);
+    if(TestEqual("Snapshot unchanged", Snapshot->Num(), 64))
+    {
+        TestEqual("Snapshot value", (*Snapshot)[0].Get<FVector>(), FVector(0.0));
+    }
+
+    // Test workers can read the snapshot
+    std::atomic<int32> NumRead = 0;
+    ParallelFor(Snapshot->Num(), [&Snapshot, &NumRead](int32 Index)
+    {
+        if((*Snapshot)[Index].GetScriptStruct() == TBaseStructure<FVector>::Get())
+        {
+            ++NumRead;
+        }
+    });
+    TestEqual("Read on workers", NumRead.load(), 64);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContainerWrappersHistoryTest, "AnastacioUtilityToolkit.UtilityModule.ContainerWrappers.History", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FContainerWrappersHistoryTest::RunTest(const FString& Parameters)
+{
+    UTkManagerStructsArray* Manager = NewObject<UTkManagerStructsArray>();
+    Manager->bRecordHistory = true;
+    for(int32 i = 0; i < 4; ++i)
+    {
+        Manager->Emplace<FVector>(static_cast<double>(i), 0.0, 0.0);
+    }
+
+    // Test a set is undone and redone
+    Manager->SetAt(1, FInstancedStruct::Make(FVector(1.0, 5.0, 0.0)));
+    TestTrue("Undo set", Manager->Undo());
+    TestEqual("Old value back", Manager->GetView()[1].Get<FVector>(), FVector(1.0, 0.0, 0.0));
+    TestTrue("Redo set", Manager->Redo());
+    TestEqual("New value back", Manager->GetView()[1].Get<FVector>(), FVector(1.0, 5.0, 0.0));
+
+    // Test edits of a transaction are undone together
+    Manager->BeginEditTransaction();
+    Manager->RemoveAtIndices_BP({ 0, 2 });
+    Manager->RemoveAtSwap_BP(0);
+    Manager->EndEditTransaction();
+    TestEqual("Removed", Manager->Num(), 1);
+    TestTrue("Undo transaction", Manager->Undo());
+    if(TestEqual("Restored", Manager->Num(), 4))
+    {
+        for(int32 i = 0; i < 4; ++i)
+        {
+            TestEqual("Order restored", Manager->GetView()[i].Get<FVector>().X, static_cast<double>(i));
+        }
+    }
+
+    // Test a new edit drops the redo
+    Manager->Clear_BP();
+    TestFalse("No redo after an edit", Manager->CanRedo());
+    TestTrue("Undo clear", Manager->Undo());
+    TestEqual("Clear undone", Manager->Num(), 4);
+
+    // Test the oldest edits are forgotten past the budget
+    Manager->HistoryMemoryBudgetKB = 0;
+    Manager->Add(FInstancedStruct::Make(FVector(4.0)));
+    TestTrue("Last edit kept", Manager->Undo());
+    TestFalse("Older edits forgotten", Manager->CanUndo());
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContainerWrappersJournalTest, "AnastacioUtilityToolkit.UtilityModule.ContainerWrappers.Journal", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FContainerWrappersJournalTest::RunTest(const FString& Parameters)
+{
+    const FString BasePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AtkJournalTest"));
+    IFileManager::Get().Delete(*FAtkStructArrayJournal::GetSnapshotPath(BasePath));
+    IFileManager::Get().Delete(*FAtkStructArrayJournal::GetJournalPath(BasePath));
+
+    UTkManagerStructsArray* Manager = NewObject<UTkManagerStructsArray>();
+    TestTrue("Nothing saved opens empty", Manager->OpenJournal(BasePath));
+    for(int32 i = 0; i < 4; ++i)
+    {
+        Manager->Emplace<FVector>(static_cast<double>(i), 0.0, 0.0);
+    }
+    Manager->SetAt(1, FInstancedStruct::Make(FVector(1.0, 5.0, 0.0)));
+    Manager->RemoveAtIndices_BP({ 0, 2 });
+    Manager->Swap_BP(0, 1);
+    Manager->CloseJournal();
+
+    // Test the edits are replayed over the snapshot
+    UTkManagerStructsArray* Loaded = NewObject<UTkManagerStructsArray>();
+    TestTrue("Loaded", Loaded->OpenJournal(BasePath));
+    if(TestEqual("Loaded count", Loaded->Num(), 2))
+    {
+        TestEqual("Swapped", Loaded->GetView()[0].Get<FVector>(), FVector(3.0, 0.0, 0.0));
+        TestEqual("Changed property", Loaded->GetView()[1].Get<FVector>(), FVector(1.0, 5.0, 0.0));
+    }
+
+    // Test a record torn by a crash only loses that record
+    Loaded->Add(FInstancedStruct::Make(FVector(4.0)));
+    Loaded->CloseJournal();
+    {
+        TUniquePtr<FArchive> Appender(IFileManager::Get().CreateFileWriter(*FAtkStructArrayJournal::GetJournalPath(BasePath), FILEWRITE_Append));
+        uint32 TornSize = 64;
+        *Appender << TornSize;
+    }
+    AddExpectedError(TEXT("torn or invalid record"), EAutomationExpectedErrorFlags::Contains, 1);
+    TestTrue("Loaded after crash", Manager->OpenJournal(BasePath));
+    TestEqual("Records before the torn one kept", Manager->Num(), 3);
+
+    // Test compacting on every edit keeps the saved structs
+    Manager->JournalCompactionThresholdKB = 0;
+    Manager->Add(FInstancedStruct::Make(FVector(5.0)));
+    Manager->SetAt(0, FInstancedStruct::Make(FVector(-1.0)));
+    Manager->CloseJournal();
+    TestTrue("Loaded after compaction", Loaded->OpenJournal(BasePath));
+    if(TestEqual("Compacted count", Loaded->Num(), 4))
+    {
+        TestEqual("Compacted first", Loaded->GetView()[0].Get<FVector>(), FVector(-1.0));
+        TestEqual("Compacted last", Loaded->GetView()[3].Get<FVector>(), FVector(5.0));
+    }
+    Loaded->CloseJournal();
+
+    // Test removals that trigger a compaction are part of the snapshot
+    TestTrue("Reopened", Manager->OpenJournal(BasePath));
+    Manager->RemoveAtIndices_BP({ 1 });
+    Manager->RemoveAtSwap_BP(0);
+    Manager->Remove_BP(FInstancedStruct::Make(FVector(4.0)));
+    Manager->CloseJournal();
+    TestTrue("Loaded after compacted removals", Loaded->OpenJournal(BasePath));
+    if(TestEqual("Removals saved", Loaded->Num(), 1))
+    {
+        TestEqual("Remaining", Loaded->GetView()[0].Get<FVector>(), FVector(5.0));
+    }
+    Loaded->CloseJournal();
+
+    // Test a snapshot holding structs whose layout changed fails to open and is not overwritten
+    {
+        TArray<uint8> Snapshot;
+        FMemoryWriter Writer(Snapshot);
+        uint32 Magic = 0x4A4B5441;
+        uint16 Version = 2;
+        uint32 Generation = 1;
+        Writer << Magic << Version << Generation;
+        auto WriteRecord = [&Writer](TFunctionRef<void(FArchive&)> WritePayload)
+        {
+            TArray<uint8> Payload;
+            FMemoryWriter PayloadWriter(Payload);
+            WritePayload(PayloadWriter);
+            uint32 Size = Payload.Num();
+            uint32 Crc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+            Writer << Size << Crc;
+            Writer.Serialize(Payload.GetData(), Payload.Num());
+        };
+        WriteRecord([](FArchive& Ar)
+        {
+            uint8 Type = 0;
+            FString Path = TBaseStructure<FVector>::Get()->GetPathName();
+            uint64 OutdatedLayoutHash = 1;
+            Ar << Type << Path << OutdatedLayoutHash;
+        });
+        WriteRecord([](FArchive& Ar)
+        {
+            uint8 Type = 1;
+            int32 Index = 0;
+            int32 Count = 1;
+            int32 SchemaIndex = 0;
+            int32 Size = 0;
+            Ar << Type << Index << Count << SchemaIndex << Size;
+        });
+        IFileManager::Get().Delete(*FAtkStructArrayJournal::GetJournalPath(BasePath));
+        FFileHelper::SaveArrayToFile(Snapshot, *FAtkStructArrayJournal::GetSnapshotPath(BasePath));
+
+        AddExpectedError(TEXT("no longer match their type"), EAutomationExpectedErrorFlags::Contains, 1);
+        TestFalse("Outdated structs fail to open", Loaded->OpenJournal(BasePath));
+        TestFalse("No journal", Loaded->IsJournalOpen());
+        TArray<uint8> OnDisk;
+        FFileHelper::LoadFileToArray(OnDisk, *FAtkStructArrayJournal::GetSnapshotPath(BasePath));
+        TestTrue("Snapshot left untouched", OnDisk == Snapshot);
+    }
+    return true;
+}
@@ -0,0 +1,33 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#else
+#include "InstancedStruct.h"
+#endif
+#include "ContainerWrappers/ArrayChangeSet.h"
+#include "ContainerWrappersTest.generated.h"
+
+// Records what the Blueprint facing events of an array manager deliver
+UCLASS()
+class UAtkTestArrayEventRecorder : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	TArray<FAtkArrayDelta> Deltas;
+	TArray<FInstancedStruct> RemovedStructs;
+	TArray<FAtkArrayChangeSet> Batches;
+
+	UFUNCTION()
+	void OnArrayDelta(const FAtkArrayDelta &Delta) { Deltas.Add(Delta); }
+
+	UFUNCTION()
+	void OnStructRemoved(const FInstancedStruct &Struct) { RemovedStructs.Add(Struct); }
+
+	UFUNCTION()
+	void OnBatchCommitted(const FAtkArrayChangeSet &Changes) { Batches.Add(Changes); }
+};
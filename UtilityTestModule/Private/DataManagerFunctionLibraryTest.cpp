@@ -4,6 +4,7 @@
 #include "Misc/AutomationTest.h"
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
 #include "Engine/DataTable.h"
 #include "BlueprintLibrary/DataManagerFunctionLibrary.h"
 
@@ -69,4 +70,103 @@ bool FDataManagerFlJsonTest::RunTest(const FString& Parameters)
     }
     
     return true;
-}
\ No newline at end of file
+}
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDataManagerFlBinaryTest, "AnastacioUtilityToolkit.UtilityModule.DataManagerFL.Binary", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FDataManagerFlBinaryTest::RunTest(const FString& Parameters)
+{
+    // Test Write/Read InstancedStructs through the binary row format
+    {
+        const FAtkDataManagerTestBase TestBase;
+        const FString BinaryPath = FPaths::Combine(TestBase.TestDir, TEXT("TestData.bin"));
+        const TArray<FInstancedStruct> InstancedStructs = TestBase.CreateMockInstancedStructsArray();
+        TestTrue("WriteInstancedStructArrayToBinary should succeed", UAtkDataManagerFunctionLibrary::WriteInstancedStructArrayToBinary(BinaryPath, InstancedStructs));
+        
+        const TArray<FInstancedStruct> ReadFromFile = UAtkDataManagerFunctionLibrary::LoadCustomDataFromBinary(BinaryPath);
+        TestEqual("Structs written to file equal to read", ReadFromFile.Num(), InstancedStructs.Num());
+        for (int32 i = 0; i < FMath::Min(ReadFromFile.Num(), InstancedStructs.Num()); ++i)
+        {
+            TestTrue("Row round trip", ReadFromFile[i] == InstancedStructs[i]);
+        }
+    }
+
+    // Test names and objects are written by name and path and resolved again when read
+    {
+        const FAtkDataManagerTestBase TestBase;
+        const FString BinaryPath = FPaths::Combine(TestBase.TestDir, TEXT("TestReferences.bin"));
+        FAtkTestReferenceRow Row;
+        Row.Value = 7;
+        Row.Tag = TEXT("AtkRowTestTag");
+        Row.Object = FTestStruct::StaticStruct();
+        Row.Scale = 2.5f;
+        TestTrue("Write references", UAtkDataManagerFunctionLibrary::WriteInstancedStructArrayToBinary(BinaryPath, { FInstancedStruct::Make(Row) }));
+
+        TArray<uint8> Bytes;
+        FFileHelper::LoadFileToArray(Bytes, *BinaryPath);
+        const auto ContainsText = [&Bytes](const FString& Text)
+        {
+            const FTCHARToUTF8 Utf8(*Text);
+            for(int32 Offset = 0; Offset + Utf8.Length() <= Bytes.Num(); ++Offset)
+            {
+                if(FMemory::Memcmp(Bytes.GetData() + Offset, Utf8.Get(), Utf8.Length()) == 0)
+                    return true;
+            }
+            return false;
+        };
+        TestTrue("Name written as text", ContainsText(Row.Tag.ToString()));
+        TestTrue("Object written as path", ContainsText(FTestStruct::StaticStruct()->GetName()));
+
+        const TArray<FInstancedStruct> ReadFromFile = UAtkDataManagerFunctionLibrary::LoadCustomDataFromBinary(BinaryPath);
+        if(TestEqual("Reference row read", ReadFromFile.Num(), 1))
+        {
+            const FAtkTestReferenceRow& ReadRow = ReadFromFile[0].Get<FAtkTestReferenceRow>();
+            TestEqual("Value", ReadRow.Value, Row.Value);
+            TestEqual("Name", ReadRow.Tag, Row.Tag);
+            TestTrue("Object", ReadRow.Object == Row.Object);
+            TestEqual("Scale", ReadRow.Scale, Row.Scale);
+        }
+    }
+
+    // Test a stream with a bad header is rejected
+    {
+        const FAtkDataManagerTestBase TestBase;
+        const FString BinaryPath = FPaths::Combine(TestBase.TestDir, TEXT("TestData.bin"));
+        bool bResult = false;
+        FString Message;
+        UAtkDataManagerFunctionLibrary::WriteStringToFile(BinaryPath, TEXT("not a row stream"), bResult, Message);
+        AddExpectedError(TEXT("unknown header"), EAutomationExpectedErrorFlags::Contains, 1);
+        TestTrue("Nothing is read", UAtkDataManagerFunctionLibrary::LoadCustomDataFromBinary(BinaryPath).IsEmpty());
+    }
+
+    // Test a row claiming more bytes than the stream holds is rejected before anything is allocated
+    {
+        const FAtkDataManagerTestBase TestBase;
+        const FString BinaryPath = FPaths::Combine(TestBase.TestDir, TEXT("TestData.bin"));
+        FAtkTestReferenceRow Row;
+        Row.Value = 7;
+        TestTrue("Write row", UAtkDataManagerFunctionLibrary::WriteInstancedStructArrayToBinary(BinaryPath, { FInstancedStruct::Make(Row) }));
+
+        // the payload size is followed by the payload and the end record
+        TArray<uint8> Bytes;
+        FFileHelper::LoadFileToArray(Bytes, *BinaryPath);
+        bool bPatched = false;
+        for(int32 Offset = Bytes.Num() - 5; Offset >= 0 && !bPatched; --Offset)
+        {
+            int32 PayloadSize = 0;
+            FMemory::Memcpy(&PayloadSize, Bytes.GetData() + Offset, sizeof(PayloadSize));
+            if(PayloadSize == Bytes.Num() - 1 - (Offset + static_cast<int32>(sizeof(PayloadSize))))
+            {
+                PayloadSize = MAX_int32;
+                FMemory::Memcpy(Bytes.GetData() + Offset, &PayloadSize, sizeof(PayloadSize));
+                bPatched = true;
+            }
+        }
+        TestTrue("Payload size found", bPatched);
+        FFileHelper::SaveArrayToFile(Bytes, *BinaryPath);
+        AddExpectedError(TEXT("Struct row stream is corrupted"), EAutomationExpectedErrorFlags::Contains, 1);
+        TestTrue("Oversized row is not read", UAtkDataManagerFunctionLibrary::LoadCustomDataFromBinary(BinaryPath).IsEmpty());
+    }
+    
+    return true;
+}
@@ -38,6 +38,25 @@ struct FTestStruct : public FTableRowBase
 	}
 };
 
+// Row holding a name and an object reference, which the binary format must write by name and path
+USTRUCT()
+struct FAtkTestReferenceRow
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Value = 0;
+
+	UPROPERTY()
+	FName Tag;
+
+	UPROPERTY()
+	TObjectPtr<UObject> Object = nullptr;
+
+	UPROPERTY()
+	float Scale = 0.f;
+};
+
 // Create a base class for shared test setup
 class FAtkDataManagerTestBase
 {
@@ -0,0 +1,694 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#include "StructUtilsFunctionLibraryTest.h"
+#include "DataManagerFunctionLibraryTest.h"
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "BlueprintLibrary/ADStructUtilsFunctionLibrary.h"
+#include "BlueprintLibrary/PropertyUtilityFunctionLibrary.h"
+#include "ContainerWrappers/TypePartitionedStructArray.h"
+#include "Reflection/ObjectPropertyAccessor.h"
+#include "Reflection/StructLayout.h"
+#include "Reflection/StructMigration.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <limits>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlStringImportTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.StringImport", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlStringImportTest::RunTest(const FString& Parameters)
+{
+    // Test every property type goes through its own parser
+    {
+        FInstancedStruct Instance = FInstancedStruct::Make(FAtkTestPropertiesStruct());
+        TestTrue("int64 value is imported", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("BigValue"), TEXT("9000000000")));
+        TestTrue("double value is imported", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("Weight"), TEXT("2.5")));
+        TestTrue("bool value is imported", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("bEnabled"), TEXT("true")));
+        TestTrue("name value is imported", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("Tag"), TEXT("Capital")));
+        TestTrue("enum value is imported", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("Enum"), TEXT("Third")));
+        TestTrue("nested vector is imported", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("Location"), TEXT("1,2,3")));
+        TestTrue("nested string is imported", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("Label"), TEXT("Label")));
+
+        const FAtkTestPropertiesStruct& Result = Instance.Get<FAtkTestPropertiesStruct>();
+        TestEqual("int64 value", Result.BigValue, 9000000000ll);
+        TestEqual("double value", Result.Weight, 2.5);
+        TestTrue("bool value", Result.bEnabled);
+        TestEqual("name value", Result.Tag, FName("Capital"));
+        TestTrue("enum value", Result.Enum == EAtkTestEnum::Third);
+        TestEqual("nested vector value", Result.Nested.Location, FVector(1.0, 2.0, 3.0));
+        TestEqual("nested string value", Result.Nested.Label, FString("Label"));
+    }
+
+    // Test invalid values are rejected instead of written as zero
+    {
+        FInstancedStruct Instance = FInstancedStruct::Make(FAtkTestPropertiesStruct());
+        UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("ID"), TEXT("7"));
+        TestFalse("text is not a valid int", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("ID"), TEXT("abc")));
+        TestFalse("unknown enum entry is rejected", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("Enum"), TEXT("Fourth")));
+        TestEqual("int value kept", Instance.Get<FAtkTestPropertiesStruct>().ID, 7);
+    }
+
+    // Test integers refuse fractions and values they cannot hold
+    {
+        FInstancedStruct Instance = FInstancedStruct::Make(FAtkTestPropertiesStruct());
+        TestFalse("fraction is not a valid int", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("ID"), TEXT("2.5")));
+        TestFalse("int overflow is rejected", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("ID"), TEXT("2147483648")));
+        TestTrue("int minimum is imported", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Instance, TEXT("ID"), TEXT("-2147483648")));
+        TestEqual("int minimum value", Instance.Get<FAtkTestPropertiesStruct>().ID, MIN_int32);
+
+        FInstancedStruct Bytes = FInstancedStruct::Make(FAtkTestBytesStruct());
+        TestFalse("byte overflow is rejected", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Bytes, TEXT("Flags"), TEXT("300")));
+        TestFalse("negative byte is rejected", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Bytes, TEXT("Flags"), TEXT("-1")));
+        TestTrue("byte maximum is imported", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Bytes, TEXT("Flags"), TEXT("255")));
+        TestEqual("byte maximum value", Bytes.Get<FAtkTestBytesStruct>().Flags, static_cast<uint8>(255));
+    }
+
+    // Test batch edits
+    {
+        FInstancedStruct Instance = FInstancedStruct::Make(FAtkTestPropertiesStruct());
+        TMap<FString, FString> Values;
+        Values.Add(TEXT("ID"), TEXT("3"));
+        Values.Add(TEXT("Scale"), TEXT("0.5"));
+        Values.Add(TEXT("Missing"), TEXT("1"));
+        TestEqual("Batch applies the valid edits", UAtkStructUtilsFunctionLibrary::SetPropertyValuesNestedInStructFromString(Instance, Values), 2);
+        TestEqual("Batch int value", Instance.Get<FAtkTestPropertiesStruct>().ID, 3);
+    }
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlDiffTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.Diff", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlDiffTest::RunTest(const FString& Parameters)
+{
+    // Test identical structs have no changes
+    {
+        const FInstancedStruct A = FInstancedStruct::Make(FAtkTestPropertiesStruct());
+        const FInstancedStruct B = A;
+        TBitArray<> Changed;
+        TestFalse("Identical structs do not differ", UAtkStructUtilsFunctionLibrary::DiffInstancedStructs(A, B, Changed));
+        TestEqual("No changed paths", UAtkStructUtilsFunctionLibrary::GetChangedPropertyPaths(A, B).Num(), 0);
+    }
+
+    // Test changed POD and nested properties are reported
+    {
+        FAtkTestPropertiesStruct Old;
+        FAtkTestPropertiesStruct New;
+        New.Weight = 4.0;
+        New.Nested.Label = TEXT("Changed");
+        const FInstancedStruct A = FInstancedStruct::Make(Old);
+        const FInstancedStruct B = FInstancedStruct::Make(New);
+
+        TBitArray<> Changed;
+        TestTrue("Structs differ", UAtkStructUtilsFunctionLibrary::DiffInstancedStructs(A, B, Changed));
+        TestEqual("Two properties differ", Changed.CountSetBits(), 2);
+
+        const TArray<FString> Paths = UAtkStructUtilsFunctionLibrary::GetChangedPropertyPaths(A, B);
+        TestEqual("Two paths differ", Paths.Num(), 2);
+        TestTrue("Weight path", Paths.Contains(TEXT("Weight")));
+        TestTrue("Nested label path", Paths.Contains(TEXT("Nested.Label")));
+    }
+
+    // Test every element of fixed size arrays is compared
+    {
+        FAtkTestFixedArrayStruct Old;
+        FAtkTestFixedArrayStruct New;
+        New.Names[2] = TEXT("Last");
+        New.Weights[1] = 1.f;
+        TBitArray<> Changed;
+        TestTrue("Later elements differ", UAtkStructUtilsFunctionLibrary::DiffStructs(FAtkTestFixedArrayStruct::StaticStruct(), &Old, &New, Changed));
+        TestEqual("Both arrays differ", Changed.CountSetBits(), 2);
+    }
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlHashTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.Hash", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlHashTest::RunTest(const FString& Parameters)
+{
+    // Test equal structs hash the same and different structs do not
+    {
+        FAtkTestPropertiesStruct Value;
+        Value.Tag = FName("Tag");
+        Value.Nested.Label = TEXT("Label");
+        const FInstancedStruct A = FInstancedStruct::Make(Value);
+        const FInstancedStruct B = FInstancedStruct::Make(Value);
+        Value.Nested.Label = TEXT("Other");
+        const FInstancedStruct C = FInstancedStruct::Make(Value);
+        
+        TestEqual("Equal structs have equal hashes", UAtkStructUtilsFunctionLibrary::GetInstancedStructHash(A), UAtkStructUtilsFunctionLibrary::GetInstancedStructHash(B));
+        TestNotEqual("Different structs have different hashes", UAtkStructUtilsFunctionLibrary::GetInstancedStructHash(A), UAtkStructUtilsFunctionLibrary::GetInstancedStructHash(C));
+    }
+
+    // Test floating point values are compared by value, not by their bytes
+    {
+        FAtkTestPlainStruct Value;
+        Value.Weight = 0.0;
+        const FInstancedStruct PositiveZero = FInstancedStruct::Make(Value);
+        Value.Weight = -0.0;
+        const FInstancedStruct NegativeZero = FInstancedStruct::Make(Value);
+        Value.Weight = 0.0;
+        Value.Value = std::numeric_limits<float>::quiet_NaN();
+        const FInstancedStruct NaN = FInstancedStruct::Make(Value);
+        
+        TestTrue("-0.0 equals 0.0", UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual(PositiveZero, NegativeZero));
+        TestEqual("-0.0 hashes like 0.0", UAtkStructUtilsFunctionLibrary::GetInstancedStructHash(PositiveZero), UAtkStructUtilsFunctionLibrary::GetInstancedStructHash(NegativeZero));
+        TestFalse("NaN never equals itself", UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual(NaN, NaN));
+        TestEqual("Integers still form a comparable run", FAtkStructLayout::Get(FAtkTestPlainStruct::StaticStruct())->GetComparableRuns().Num(), 1);
+    }
+
+    // Test a native Identical operator is used over the bytes
+    {
+        FAtkTestIdenticalStruct Value;
+        Value.Value = 1;
+        const FInstancedStruct A = FInstancedStruct::Make(Value);
+        Value.CachedValue = 2;
+        const FInstancedStruct B = FInstancedStruct::Make(Value);
+        TestTrue("Native Identical decides", UAtkStructUtilsFunctionLibrary::AreInstancedStructsEqual(A, B));
+    }
+
+    // Test duplicates are removed and order is kept
+    {
+        FAtkTestPropertiesStruct First;
+        First.ID = 1;
+        FAtkTestPropertiesStruct Second;
+        Second.ID = 2;
+        TArray<FInstancedStruct> Array = { FInstancedStruct::Make(First), FInstancedStruct::Make(Second), FInstancedStruct::Make(First) };
+        TestEqual("One duplicate removed", UAtkStructUtilsFunctionLibrary::RemoveDuplicateStructs(Array), 1);
+        TestEqual("Two structs left", Array.Num(), 2);
+        TestEqual("Order kept", Array[1].Get<FAtkTestPropertiesStruct>().ID, 2);
+
+        FAtkTestPlainStruct Zero;
+        Zero.Weight = 0.0;
+        FAtkTestPlainStruct NegativeZero;
+        NegativeZero.Weight = -0.0;
+        TArray<FInstancedStruct> Zeros = { FInstancedStruct::Make(Zero), FInstancedStruct::Make(NegativeZero) };
+        TestEqual("-0.0 is a duplicate of 0.0", UAtkStructUtilsFunctionLibrary::RemoveDuplicateStructs(Zeros), 1);
+    }
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlTypedAccessTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.TypedAccess", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlTypedAccessTest::RunTest(const FString& Parameters)
+{
+    FAtkTestPropertiesStruct Value;
+    Value.BigValue = 9000000000ll;
+    Value.Weight = 1.5;
+    Value.Enum = EAtkTestEnum::Second;
+    FInstancedStruct Instance = FInstancedStruct::Make(Value);
+    
+    // Test each type only matches its own property class
+    {
+        const UScriptStruct* StructType = FAtkTestPropertiesStruct::StaticStruct();
+        TestTrue("int64 matches int64 property", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<int64>(StructType, FName("BigValue")));
+        TestFalse("int32 does not match int64 property", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<int32>(StructType, FName("BigValue")));
+        TestTrue("double matches double property", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<double>(StructType, FName("Weight")));
+        TestFalse("float does not match double property", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<float>(StructType, FName("Weight")));
+        TestTrue("enum matches enum property", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<EAtkTestEnum>(StructType, FName("Enum")));
+        TestTrue("struct matches struct property", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<FAtkTestNestedStruct>(StructType, FName("Nested")));
+    }
+
+    // Test enum bytes only match enum types and unsupported types are rejected instead of failing to compile
+    {
+        const UScriptStruct* StructType = FAtkTestBytesStruct::StaticStruct();
+        TestTrue("uint8 matches byte property", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<uint8>(StructType, FName("Flags")));
+        TestFalse("uint8 does not match enum byte property", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<uint8>(StructType, FName("Mode")));
+        TestTrue("TEnumAsByte matches enum byte property", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<TEnumAsByte<EAtkTestByteEnum::Type>>(StructType, FName("Mode")));
+        TestFalse("TEnumAsByte of another enum does not match", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<TEnumAsByte<EAtkTestOtherByteEnum::Type>>(StructType, FName("Mode")));
+        TestFalse("Containers are not supported", UAtkStructUtilsFunctionLibrary::StructHasPropertyOfTypeWithName<TArray<int32>>(StructType, FName("Values")));
+        TestTrue("Core structs are supported", TPropertyTraits<FVector>::bSupported);
+        TestFalse("Containers are not structs", TPropertyTraits<TArray<int32>>::bSupported);
+    }
+
+    // Test typed reads and writes
+    {
+        bool bResult = false;
+        TestEqual("int64 read", UAtkStructUtilsFunctionLibrary::GetPropertyValueFromStruct<int64>(Instance, TEXT("BigValue"), bResult), 9000000000ll);
+        TestTrue("int64 read succeeded", bResult);
+        TestTrue("enum read", UAtkStructUtilsFunctionLibrary::GetPropertyValueFromStruct<EAtkTestEnum>(Instance, TEXT("Enum"), bResult) == EAtkTestEnum::Second);
+        TestTrue("double write", UAtkStructUtilsFunctionLibrary::SetPropertyValueInStruct<double>(Instance, TEXT("Weight"), 3.0));
+        TestEqual("double written", Instance.Get<FAtkTestPropertiesStruct>().Weight, 3.0);
+    }
+
+    // Test objects of the wrong class are refused instead of silently dropped
+    {
+        FInstancedStruct Bytes = FInstancedStruct::Make(FAtkTestBytesStruct());
+        UObject* WrongClass = UObject::StaticClass();
+        UObject* RightClass = FAtkTestBytesStruct::StaticStruct();
+        TestFalse("Object of another class is refused", UAtkStructUtilsFunctionLibrary::SetPropertyValueInStruct<UObject*>(Bytes, TEXT("StructType"), WrongClass));
+        TestTrue("Object of the property class is set", UAtkStructUtilsFunctionLibrary::SetPropertyValueInStruct<UObject*>(Bytes, TEXT("StructType"), RightClass));
+        TestTrue("Object written", Bytes.Get<FAtkTestBytesStruct>().StructType == FAtkTestBytesStruct::StaticStruct());
+    }
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlCreateArrayTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.CreateArray", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlCreateArrayTest::RunTest(const FString& Parameters)
+{
+    // Test small arrays built on the calling thread with a plain old data default
+    FAtkTestPlainStruct PlainDefault;
+    PlainDefault.Count = 7;
+    PlainDefault.Weight = 2.5;
+    const TArray<FInstancedStruct> Small = UAtkStructUtilsFunctionLibrary::CreateInstancedStructArray(100, FInstancedStruct::Make(PlainDefault));
+    TestEqual("Small size", Small.Num(), 100);
+    TestEqual("Plain default copied", Small[99].Get<FAtkTestPlainStruct>().Count, 7);
+    TestTrue("Separate payloads", Small[0].GetMemory() != Small[1].GetMemory());
+
+    // Test large arrays built in parallel with a default that owns memory
+    FAtkTestPropertiesStruct Default;
+    Default.ID = 3;
+    Default.Tag = FName(TEXT("Tag"));
+    Default.Nested.Label = TEXT("Default");
+    TArray<FInstancedStruct> Large = UAtkStructUtilsFunctionLibrary::CreateInstancedStructArray(20000, FInstancedStruct::Make(Default));
+    TestEqual("Large size", Large.Num(), 20000);
+    const bool bAllDefault = Large.ContainsByPredicate([](const FInstancedStruct& Struct)
+    {
+        const FAtkTestPropertiesStruct* Value = Struct.GetPtr<FAtkTestPropertiesStruct>();
+        return !Value || Value->ID != 3 || Value->Tag != FName(TEXT("Tag")) || Value->Nested.Label != TEXT("Default");
+    }) == false;
+    TestTrue("Every payload is a copy of the default", bAllDefault);
+    Large[0].GetMutable<FAtkTestPropertiesStruct>().Nested.Label = TEXT("Changed");
+    TestEqual("Deep copies", Large[15000].Get<FAtkTestPropertiesStruct>().Nested.Label, FString(TEXT("Default")));
+
+    // Test empty requests
+    TestEqual("No size", UAtkStructUtilsFunctionLibrary::CreateInstancedStructArray(0, FInstancedStruct::Make(Default)).Num(), 0);
+    const TArray<FInstancedStruct> Empty = UAtkStructUtilsFunctionLibrary::CreateInstancedStructArray(10, FInstancedStruct());
+    TestTrue("Invalid default gives empty structs", Empty.Num() == 10 && !Empty[5].IsValid());
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlSharedDefaultTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.SharedDefault", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlSharedDefaultTest::RunTest(const FString& Parameters)
+{
+    FAtkSharedDefaultStructArray Array(1000, FInstancedStruct::Make(FAtkTestPropertiesStruct()));
+    TestEqual("No element owns a payload", Array.NumOwned(), 0);
+
+    // Test only written elements get their own copy
+    TestTrue("Typed write", UAtkStructUtilsFunctionLibrary::SetPropertyValueInStruct<int32>(Array, 10, TEXT("ID"), 5));
+    TestTrue("String write", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Array, 20, TEXT("Weight"), TEXT("2.0")));
+    TestFalse("Invalid write", UAtkStructUtilsFunctionLibrary::SetPropertyValueNestedInStructFromString(Array, 30, TEXT("Weight"), TEXT("abc")));
+    TestEqual("Two elements own a payload", Array.NumOwned(), 2);
+    TestEqual("Written value", Array.Get(10).Get<FAtkTestPropertiesStruct>().ID, 5);
+    TestEqual("Shared value", Array.Get(11).Get<FAtkTestPropertiesStruct>().ID, 0);
+
+    // Test writing the default back releases the copy
+    Array.Set(10, Array.GetDefault());
+    TestEqual("One element owns a payload", Array.NumOwned(), 1);
+
+    // Test an invalid value shares the default instead of owning an empty payload
+    Array.Set(20, FInstancedStruct());
+    Array.Set(40, FInstancedStruct());
+    TestEqual("Invalid values own no payload", Array.NumOwned(), 0);
+    TestTrue("Invalid value reads the default", Array.IsShared(20) && Array.Get(20).GetScriptStruct() == FAtkTestPropertiesStruct::StaticStruct());
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlStructBufferTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.StructBuffer", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlStructBufferTest::RunTest(const FString& Parameters)
+{
+    TArray<FInstancedStruct> Instances;
+    for (int32 i = 0; i < 10; ++i)
+    {
+        FAtkTestPropertiesStruct Value;
+        Value.ID = i;
+        Value.Nested.Label = FString::FromInt(i);
+        Instances.Add(FInstancedStruct::Make(Value));
+    }
+    Instances.Add(FInstancedStruct::Make(FAtkTestNestedStruct()));
+
+    // Test only structs of the first type are copied in
+    FAtkStructBuffer Buffer = UAtkStructUtilsFunctionLibrary::MakeStructBuffer(Instances);
+    TestEqual("Mismatching struct is skipped", Buffer.Num(), 10);
+    TestEqual("Stride is the struct size", Buffer.GetStride(), FAtkTestPropertiesStruct::StaticStruct()->GetStructureSize());
+
+    // Test elements are laid out contiguously and keep their values
+    TArrayView<FAtkTestPropertiesStruct> View = Buffer.AsArrayView<FAtkTestPropertiesStruct>();
+    TestEqual("View covers every element", View.Num(), 10);
+    TestEqual("Contiguous value", View[7].ID, 7);
+    TestEqual("Non trivial member is copied", View[7].Nested.Label, FString(TEXT("7")));
+
+    // Test removal destroys and compacts
+    Buffer.RemoveAt(0);
+    TestEqual("Removed element", Buffer.Get<FAtkTestPropertiesStruct>(0).ID, 1);
+    Buffer.RemoveAtSwap(0);
+    TestEqual("Swapped element", Buffer.Get<FAtkTestPropertiesStruct>(0).ID, 9);
+
+    // Test copies are deep
+    FAtkStructBuffer Copy = Buffer;
+    Copy.Get<FAtkTestPropertiesStruct>(0).Nested.Label = TEXT("Changed");
+    TestEqual("Source is untouched", Buffer.Get<FAtkTestPropertiesStruct>(0).Nested.Label, FString(TEXT("9")));
+    TestEqual("Round trip", UAtkStructUtilsFunctionLibrary::StructBufferToArray(Copy).Num(), Copy.Num());
+
+    // Test adding an element of the buffer to itself survives the buffer growing
+    const int32 NumBeforeSelfAdd = Copy.Num();
+    for (int32 i = 0; i < 32; ++i)
+    {
+        Copy.Add(Copy.GetAt(0));
+    }
+    TestEqual("Self adds are appended", Copy.Num(), NumBeforeSelfAdd + 32);
+    TestEqual("Self add copies the source value", Copy.Get<FAtkTestPropertiesStruct>(Copy.Num() - 1).Nested.Label, FString(TEXT("Changed")));
+
+    // Test appending to a buffer without a struct type does nothing
+    FAtkStructBuffer Untyped;
+    TestEqual("Untyped buffer appends nothing", Untyped.Append(Instances), 0);
+    TestEqual("Untyped buffer stays empty", Untyped.Num(), 0);
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlTypePartitionedTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.TypePartitioned", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlTypePartitionedTest::RunTest(const FString& Parameters)
+{
+    FAtkTypePartitionedStructArray Array;
+    for (int32 i = 0; i < 6; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            FAtkTestPropertiesStruct Value;
+            Value.ID = i;
+            Array.Add(Value);
+        }
+        else
+        {
+            FAtkTestNestedStruct Value;
+            Value.Label = FString::FromInt(i);
+            Array.Add(Value);
+        }
+    }
+    TestEqual("Two buckets", Array.NumTypes(), 2);
+    TestEqual("Dense bucket", Array.FindBucket(FAtkTestPropertiesStruct::StaticStruct())->Num(), 3);
+
+    // Test type filtered iteration only sees its own bucket
+    int32 Sum = 0;
+    Array.ForEachOfType<FAtkTestPropertiesStruct>([&Sum](const FAtkTestPropertiesStruct& Value)
+    {
+        Sum += Value.ID;
+    });
+    TestEqual("Typed sum", Sum, 6);
+
+    const FAtkPartitionedHandle FirstHandle = Array.GetHandle(0);
+    const FAtkPartitionedHandle SecondHandle = Array.GetHandle(1);
+    const FAtkPartitionedHandle LastHandle = Array.GetHandle(5);
+
+    // Test ordered removal keeps the original order and the back pointers
+    Array.RemoveAt(0);
+    TestEqual("Order is kept", Array.GetAt(0).Get<FAtkTestNestedStruct>().Label, FString(TEXT("1")));
+    TestEqual("Moved element is patched", Array.GetAt(1).Get<FAtkTestPropertiesStruct>().ID, 2);
+    for (int32 i = 0; i < Array.Num(); ++i)
+    {
+        TestEqual("Global index round trip", Array.GetGlobalIndex(Array.GetPartitionedIndex(i)), i);
+    }
+
+    // Test swap removal
+    Array.RemoveAtSwap(0);
+    TestEqual("Last element is moved", Array.GetAt(0).Get<FAtkTestNestedStruct>().Label, FString(TEXT("5")));
+    TestEqual("Back to array", Array.ToArray().Num(), 4);
+
+    // Test handles follow their element across removals and stop resolving once it is removed
+    TestFalse("Removed element handle", Array.IsValidHandle(FirstHandle));
+    TestEqual("Handle follows the moved element", Array.GetGlobalIndex(LastHandle), 0);
+    TestEqual("Handle view", Array.Find(LastHandle).Get<FAtkTestNestedStruct>().Label, FString(TEXT("5")));
+    const FAtkPartitionedHandle ReusedHandle = Array.GetHandle(Array.Add(FAtkTestNestedStruct()));
+    TestTrue("Reused slot gets a new generation", ReusedHandle != SecondHandle && ReusedHandle.Slot == SecondHandle.Slot);
+    TestFalse("Stale handle on a reused slot", Array.Find(SecondHandle).IsValid());
+    Array.Remove(LastHandle);
+    TestEqual("Removed by handle", Array.Num(), 4);
+    TestEqual("Handle after an ordered removal", Array.GetGlobalIndex(ReusedHandle), 3);
+    Array.Reset();
+    TestFalse("Reset invalidates handles", Array.IsValidHandle(ReusedHandle));
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlParallelVisitTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.ParallelVisit", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlParallelVisitTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 Count = 5000;
+    TArray<FInstancedStruct> Instances;
+    int64 ExpectedSum = 0;
+    for (int32 i = 0; i < Count; ++i)
+    {
+        FAtkTestPropertiesStruct Value;
+        Value.ID = i;
+        ExpectedSum += i;
+        Instances.Add(FInstancedStruct::Make(Value));
+        if (i % 10 == 0)
+        {
+            Instances.Add(FInstancedStruct::Make(FAtkTestNestedStruct()));
+        }
+    }
+
+    // Test the typed visitor only touches its own type
+    UAtkStructUtilsFunctionLibrary::ParallelForEachStructOfType<FAtkTestPropertiesStruct>(Instances, [](FAtkTestPropertiesStruct& Value)
+    {
+        Value.bEnabled = true;
+    }, 64);
+    const int32 NumEnabled = UAtkStructUtilsFunctionLibrary::ParallelMapReduceOfType<FAtkTestPropertiesStruct>(Instances, 0,
+        [](int32& Accumulator, const FAtkTestPropertiesStruct& Value) { Accumulator += Value.bEnabled ? 1 : 0; },
+        [](int32& Result, const int32& Accumulator) { Result += Accumulator; }, 64);
+    TestEqual("Every typed struct is visited", NumEnabled, Count);
+
+    // Test the untyped aggregation sees every struct once
+    const int64 Sum = UAtkStructUtilsFunctionLibrary::ParallelMapReduce(Instances, int64(0),
+        [](int64& Accumulator, FConstStructView View)
+        {
+            if (View.GetScriptStruct() == FAtkTestPropertiesStruct::StaticStruct())
+            {
+                Accumulator += View.Get<FAtkTestPropertiesStruct>().ID;
+            }
+        },
+        [](int64& Result, const int64& Accumulator) { Result += Accumulator; }, 100);
+    TestEqual("Aggregated sum", Sum, ExpectedSum);
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlDumpTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.Dump", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlDumpTest::RunTest(const FString& Parameters)
+{
+    TArray<FInstancedStruct> Instances;
+    for (int32 i = 0; i < 100; ++i)
+    {
+        FAtkTestPropertiesStruct Value;
+        Value.ID = i;
+        Value.Nested.Label = TEXT("a,b");
+        Instances.Add(FInstancedStruct::Make(Value));
+    }
+
+    // Test sampling and row cap
+    FAtkStructDumpOptions Options;
+    Options.SampleRate = 10;
+    Options.MaxRows = 5;
+    const TArray<int32> Indices = FAtkStructDumper::GetSampledIndices(Instances.Num(), Options);
+    TestEqual("Row cap", Indices.Num(), 5);
+    TestEqual("Sample rate", Indices.Last(), 40);
+
+    // Test the csv dump with a property filter
+    const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AtkStructDump.csv"));
+    Options.Format = EAtkStructDumpFormat::Csv;
+    Options.FilePath = FilePath;
+    Options.PropertyFilter = { TEXT("ID") };
+    TestTrue("Dump written", FAtkStructDumper::DumpAsync(Instances, Options).Get());
+
+    TArray<FString> Lines;
+    FFileHelper::LoadFileToStringArray(Lines, *FilePath);
+    TestEqual("Type line, header and rows", Lines.Num(), 7);
+    if (Lines.Num() == 7)
+    {
+        TestEqual("Header", Lines[1], FString(TEXT("Index,ID")));
+        TestEqual("Sampled row", Lines[3], FString(TEXT("10,10")));
+    }
+    IFileManager::Get().Delete(*FilePath);
+
+    // Test the json dump writes non finite numbers as null and exports object references before going async
+    const FString JsonPath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AtkStructDump.json"));
+    UObject* Referenced = NewObject<UAtkTestPropertyOwner>();
+    FAtkTestReferenceRow ReferenceRow;
+    ReferenceRow.Object = Referenced;
+    ReferenceRow.Scale = std::numeric_limits<float>::infinity();
+    Options = FAtkStructDumpOptions();
+    Options.Format = EAtkStructDumpFormat::Json;
+    Options.FilePath = JsonPath;
+    Options.PropertyFilter = { TEXT("Object"), TEXT("Scale") };
+    TArray<FInstancedStruct> ReferenceRows = { FInstancedStruct::Make(ReferenceRow) };
+    TestTrue("Json dump written", FAtkStructDumper::DumpAsync(MoveTemp(ReferenceRows), Options).Get());
+
+    FString Json;
+    FFileHelper::LoadFileToString(Json, *JsonPath);
+    TestTrue("Infinity is null", Json.Contains(TEXT("\"Scale\":null")));
+    TestTrue("Object reference", Json.Contains(Referenced->GetName()));
+    IFileManager::Get().Delete(*JsonPath);
+
+    // Test single struct formatting
+    const FString Formatted = FAtkStructDumper::FormatStruct(FConstStructView::Make(Instances[3].Get<FAtkTestPropertiesStruct>()), { TEXT("ID") });
+    TestEqual("Formatted struct", Formatted, FString(TEXT("AtkTestPropertiesStruct { ID: 3 }")));
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlMigrationTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.Migration", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlMigrationTest::RunTest(const FString& Parameters)
+{
+    TArray<FInstancedStruct> Instances;
+    for (int32 i = 0; i < 3000; ++i)
+    {
+        FAtkTestPropertiesStruct Value;
+        Value.ID = i;
+        Value.BigValue = 9000000000ll;
+        Value.Scale = 0.5f;
+        Value.Tag = FName(TEXT("Weapon"));
+        Value.Nested.Label = TEXT("Nested");
+        Instances.Add(FInstancedStruct::Make(Value));
+    }
+    Instances.Add(FInstancedStruct::Make(FAtkTestNestedStruct()));
+
+    FAtkStructMigration Migration(FAtkTestPropertiesStruct::StaticStruct(), FAtkTestPropertiesStructV2::StaticStruct());
+    Migration.Rename(TEXT("Tag"), TEXT("Category")).SetDefault(TEXT("Stack"), TEXT("5"));
+    TestEqual("Every source struct is converted", Migration.MigrateArray(Instances, 256), 3000);
+    TestTrue("Unmapped field", Migration.GetUnmappedTargetProperties().Contains(FName(TEXT("Stack"))));
+
+    const FAtkTestPropertiesStructV2& Migrated = Instances[1234].Get<FAtkTestPropertiesStructV2>();
+    TestEqual("Retyped integer", Migrated.ID, int64(1234));
+    TestEqual("Same type", Migrated.BigValue, 9000000000ll);
+    TestEqual("Float to double", Migrated.Scale, 0.5);
+    TestEqual("Renamed name to string", Migrated.Category, FString(TEXT("Weapon")));
+    TestEqual("Default for new field", Migrated.Stack, 5);
+    TestEqual("Nested struct", Migrated.Nested.Label, FString(TEXT("Nested")));
+    TestTrue("Other types are untouched", Instances.Last().GetScriptStruct() == FAtkTestNestedStruct::StaticStruct());
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlMigrationExactNameTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.MigrationExactName", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlMigrationExactNameTest::RunTest(const FString& Parameters)
+{
+    FAtkTestMigrationSourceStruct Source;
+    Source.bScaleWithLevel = true;
+    Source.Scale = 2.5f;
+    Source.MaxCount = 99;
+    Source.Count = 7;
+    TArray<FInstancedStruct> Instances = { FInstancedStruct::Make(Source) };
+
+    FAtkStructMigration Migration(FAtkTestMigrationSourceStruct::StaticStruct(), FAtkTestMigrationTargetStruct::StaticStruct());
+    Migration.Rename(TEXT("Amount"), TEXT("Count"));
+    TestEqual("Source struct is converted", Migration.MigrateArray(Instances), 1);
+
+    const FAtkTestMigrationTargetStruct& Migrated = Instances[0].Get<FAtkTestMigrationTargetStruct>();
+    TestEqual("Field whose name is contained in an earlier field", Migrated.Scale, 2.5);
+    TestEqual("Field whose name is a suffix of an earlier field", Migrated.Count, 7);
+    TestEqual("Renamed to the exact source field", Migrated.Amount, 7);
+    TestNull("Substring names are not found", UAtkStructUtilsFunctionLibrary::FindPropertyByName(FAtkTestMigrationSourceStruct::StaticStruct(), TEXT("Level")));
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlObjectPropertyAccessorTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.ObjectPropertyAccessor", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlObjectPropertyAccessorTest::RunTest(const FString& Parameters)
+{
+    UAtkTestPropertyOwner* Base = NewObject<UAtkTestPropertyOwner>();
+    UAtkTestDerivedPropertyOwner* Derived = NewObject<UAtkTestDerivedPropertyOwner>();
+    Base->TargetObject = Derived;
+    Base->Target = Base;
+    Derived->Target = Derived;
+    Derived->Child = Base;
+
+    // Test the exact property is bound when its name is contained in another property name
+    const FAtkObjectPropertyAccessor TargetAccessor = FAtkObjectPropertyAccessor::Make<UAtkTestPropertyOwner>(UAtkTestPropertyOwner::StaticClass(), TEXT("Target"));
+    TestTrue("Bound", TargetAccessor.IsValid());
+    TestEqual("Exact property", TargetAccessor.GetProperty()->GetFName(), FName(TEXT("Target")));
+    TestTrue("Read", TargetAccessor.Read<UAtkTestPropertyOwner>(Base) == Base);
+    TestTrue("Read from a child class", TargetAccessor.Read(Derived) == Derived);
+    TestTrue("Read from container memory", TargetAccessor.Read(static_cast<const void*>(Base)) == Base);
+    TestFalse("Expected class mismatch", FAtkObjectPropertyAccessor::Make<UAtkTestDerivedPropertyOwner>(UAtkTestPropertyOwner::StaticClass(), TEXT("Target")).IsValid());
+    TestFalse("Substring names are not bound", FAtkObjectPropertyAccessor::Make<UObject>(UAtkTestPropertyOwner::StaticClass(), TEXT("Targ")).IsValid());
+
+    // Test batch reads skip objects that are null or not of the owner class
+    const FAtkObjectPropertyAccessor ChildAccessor = FAtkObjectPropertyAccessor::Make<UAtkTestPropertyOwner>(UAtkTestDerivedPropertyOwner::StaticClass(), TEXT("Child"));
+    TArray<const UObject*> Objects = { Derived, Base, nullptr, Derived };
+    TArray<UObject*> Values;
+    ChildAccessor.ReadBatch(Objects, Values);
+    TestEqual("One value per object", Values.Num(), 4);
+    TestTrue("Batch values", Values[0] == Base && Values[1] == nullptr && Values[2] == nullptr && Values[3] == Base);
+    TArray<UAtkTestPropertyOwner*> TypedValues;
+    ChildAccessor.ReadBatch(TArray<UAtkTestPropertyOwner*>{ Base, Derived }, TypedValues);
+    TestTrue("Typed batch values", TypedValues[0] == nullptr && TypedValues[1] == Base);
+
+    // Test a reinstanced owner class is bound again through its path
+    UClass* DerivedClass = UAtkTestDerivedPropertyOwner::StaticClass();
+    DerivedClass->ClassFlags |= CLASS_NewerVersionExists;
+    const bool bValidAfterReinstancing = ChildAccessor.IsValid();
+    UObject* const ReadAfterReinstancing = ChildAccessor.Read(Derived);
+    DerivedClass->ClassFlags &= ~CLASS_NewerVersionExists;
+    TestTrue("Bound again after reinstancing", bValidAfterReinstancing);
+    TestTrue("Read after reinstancing", ReadAfterReinstancing == Base);
+
+    // Test the instance class is searched, the property is declared on the derived class
+    TestTrue("Property of a derived class", UAtkPropertyUtilityFunctionLibrary::GetPropertyAsObjectType<UAtkTestPropertyOwner>(Derived, TEXT("Child")) == Base);
+    TestNull("Property missing on the base class", UAtkPropertyUtilityFunctionLibrary::GetPropertyAsObjectType<UAtkTestPropertyOwner>(Base, TEXT("Child")));
+    
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructUtilsFlStructViewTest, "AnastacioUtilityToolkit.UtilityModule.StructUtilsFL.StructView", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FStructUtilsFlStructViewTest::RunTest(const FString& Parameters)
+{
+    FAtkTestPropertiesStruct Value;
+    Value.Nested.Label = TEXT("Nested");
+    FInstancedStruct Instance = FInstancedStruct::Make(Value);
+
+    // Test views alias the nested struct of an instanced struct
+    const FConstStructView View = UAtkPropertyUtilityFunctionLibrary::GetStructViewFromPropertyInstancedStruct(Instance, TEXT("Nested"));
+    TestTrue("Nested struct type", View.GetScriptStruct() == FAtkTestNestedStruct::StaticStruct());
+    TestTrue("No copy", View.GetMemory() == reinterpret_cast<const uint8*>(&Instance.Get<FAtkTestPropertiesStruct>().Nested));
+    UAtkPropertyUtilityFunctionLibrary::GetMutableStructPtrFromProperty<FAtkTestNestedStruct>(Instance, TEXT("Nested"))->Label = TEXT("Written");
+    TestEqual("Write through the view", Instance.Get<FAtkTestPropertiesStruct>().Nested.Label, FString(TEXT("Written")));
+    TestNull("Wrong type", UAtkPropertyUtilityFunctionLibrary::GetStructPtrFromProperty<FAtkTestPropertiesStruct>(Instance, TEXT("Nested")));
+    TestFalse("Not a struct property", UAtkPropertyUtilityFunctionLibrary::GetStructViewFromPropertyInstancedStruct(Instance, TEXT("ID")).IsValid());
+    TestFalse("Substring names are not found", UAtkPropertyUtilityFunctionLibrary::GetStructViewFromPropertyInstancedStruct(Instance, TEXT("Nest")).IsValid());
+
+    // Test views on objects, by name and through a cached property
+    UAtkTestDerivedPropertyOwner* Object = NewObject<UAtkTestDerivedPropertyOwner>();
+    Object->Nested.Location = FVector(1.0, 2.0, 3.0);
+    const FAtkTestNestedStruct* Nested = UAtkPropertyUtilityFunctionLibrary::GetStructPtrFromProperty<FAtkTestNestedStruct>(Object, TEXT("Nested"));
+    TestTrue("Object struct pointer", Nested == &Object->Nested);
+    UAtkPropertyUtilityFunctionLibrary::GetMutableStructViewFromPropertyObj(Object, TEXT("Nested")).Get<FAtkTestNestedStruct>().Label = TEXT("Object");
+    TestEqual("Object write through the view", Object->Nested.Label, FString(TEXT("Object")));
+
+    const FProperty* NestedProperty = UAtkStructUtilsFunctionLibrary::FindPropertyByName(UAtkTestPropertyOwner::StaticClass(), TEXT("Nested"));
+    TestTrue("Cached property", UAtkPropertyUtilityFunctionLibrary::GetStructPtrFromProperty<FAtkTestNestedStruct>(NestedProperty, Object) == &Object->Nested);
+    UAtkPropertyUtilityFunctionLibrary::GetMutableStructPtrFromProperty<FAtkTestNestedStruct>(NestedProperty, Object)->Location.X = 5.0;
+    TestEqual("Cached property write", Object->Nested.Location.X, 5.0);
+    TestNull("Null container", UAtkPropertyUtilityFunctionLibrary::GetStructPtrFromProperty<FAtkTestNestedStruct>(NestedProperty, nullptr));
+    
+    return true;
+}
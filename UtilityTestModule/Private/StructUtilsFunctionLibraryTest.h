@@ -0,0 +1,246 @@
+// Copyright 2024 An@stacioDev All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_NEWER_THAN(5, 4, 4)
+#include "StructUtils/InstancedStruct.h"
+#else
+#include "InstancedStruct.h"
+#endif
+#include "StructUtilsFunctionLibraryTest.generated.h"
+
+UENUM()
+enum class EAtkTestEnum : uint8
+{
+	First,
+	Second,
+	Third
+};
+
+USTRUCT()
+struct FAtkTestNestedStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FString Label;
+};
+
+// Helper struct for testing - covers the property types the struct utils have to handle
+USTRUCT()
+struct FAtkTestPropertiesStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 ID = 0;
+
+	UPROPERTY()
+	int64 BigValue = 0;
+
+	UPROPERTY()
+	double Weight = 0.0;
+
+	UPROPERTY()
+	float Scale = 1.0f;
+
+	UPROPERTY()
+	bool bEnabled = false;
+
+	UPROPERTY()
+	FName Tag;
+
+	UPROPERTY()
+	EAtkTestEnum Enum = EAtkTestEnum::First;
+
+	UPROPERTY()
+	FAtkTestNestedStruct Nested;
+};
+
+UENUM()
+namespace EAtkTestByteEnum
+{
+	enum Type
+	{
+		Off,
+		On
+	};
+}
+
+UENUM()
+namespace EAtkTestOtherByteEnum
+{
+	enum Type
+	{
+		Low,
+		High
+	};
+}
+
+// Raw bytes next to an old style enum stored in a byte property
+USTRUCT()
+struct FAtkTestBytesStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint8 Flags = 0;
+
+	UPROPERTY()
+	TEnumAsByte<EAtkTestByteEnum::Type> Mode = EAtkTestByteEnum::Off;
+
+	UPROPERTY()
+	TArray<int32> Values;
+
+	UPROPERTY()
+	TObjectPtr<UScriptStruct> StructType = nullptr;
+};
+
+// Fixed size arrays of properties compared by value
+USTRUCT()
+struct FAtkTestFixedArrayStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Names[3];
+
+	UPROPERTY()
+	float Weights[2] = { 0.f, 0.f };
+};
+
+// Plain old data struct mixing integers and floating point values
+USTRUCT()
+struct FAtkTestPlainStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Count = 0;
+
+	UPROPERTY()
+	float Value = 0.f;
+
+	UPROPERTY()
+	double Weight = 0.0;
+};
+
+// Plain integers whose native Identical ignores the cached value
+USTRUCT()
+struct FAtkTestIdenticalStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Value = 0;
+
+	UPROPERTY()
+	int32 CachedValue = 0;
+
+	bool Identical(const FAtkTestIdenticalStruct* Other, uint32 PortFlags) const
+	{
+		return Value == Other->Value;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FAtkTestIdenticalStruct> : public TStructOpsTypeTraitsBase2<FAtkTestIdenticalStruct>
+{
+	enum
+	{
+		WithIdentical = true,
+	};
+};
+
+// Later version of FAtkTestPropertiesStruct for migration tests: retyped, renamed and new fields
+USTRUCT()
+struct FAtkTestPropertiesStructV2
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int64 ID = 0;
+
+	UPROPERTY()
+	int64 BigValue = 0;
+
+	UPROPERTY()
+	double Weight = 0.0;
+
+	UPROPERTY()
+	double Scale = 1.0;
+
+	UPROPERTY()
+	FString Category;
+
+	UPROPERTY()
+	int32 Stack = 0;
+
+	UPROPERTY()
+	FAtkTestNestedStruct Nested;
+};
+
+// Migration source whose field names contain the names of later fields
+USTRUCT()
+struct FAtkTestMigrationSourceStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool bScaleWithLevel = false;
+
+	UPROPERTY()
+	float Scale = 1.0f;
+
+	UPROPERTY()
+	int32 MaxCount = 0;
+
+	UPROPERTY()
+	int32 Count = 0;
+};
+
+USTRUCT()
+struct FAtkTestMigrationTargetStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	double Scale = 1.0;
+
+	UPROPERTY()
+	int32 Count = 0;
+
+	UPROPERTY()
+	int32 Amount = 0;
+};
+
+// Property owners for the property accessor and struct view tests, Target is contained in the name of the property declared before it
+UCLASS()
+class UAtkTestPropertyOwner : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TObjectPtr<UObject> TargetObject;
+
+	UPROPERTY()
+	TObjectPtr<UAtkTestPropertyOwner> Target;
+
+	UPROPERTY()
+	FAtkTestNestedStruct Nested;
+};
+
+UCLASS()
+class UAtkTestDerivedPropertyOwner : public UAtkTestPropertyOwner
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TObjectPtr<UAtkTestPropertyOwner> Child;
+};